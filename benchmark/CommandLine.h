@@ -0,0 +1,16 @@
+// Command line helpers shared by the native tools (selfplay.cpp, bookgen.cpp).
+#pragma once
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parses a comma-separated list such as "5,7,9,11".
+inline std::vector<int> parseIntList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) values.push_back(std::atoi(item.c_str()));
+    return values;
+}
@@ -1,7 +1,15 @@
+import fs from 'fs';
 import createQuoridorAIModule from '../public/ai/ai.js';
 
 // --- Configuration ---
 const BENCHMARK_DEPTH = 4;
+const MCTS_TIME_MS = 2000;
+const MCTS_MAX_THREADS = 8;
+const NNUE_WEIGHTS_PATH = new URL('../public/ai/nnue.bin', import.meta.url);
+
+// Must match the layout documented in client/src/ai/Nnue.h.
+const NNUE_FEATURE_COUNT = 4 * 11 * 11 + 2 * 10 * 10 + 4 * 11;
+const NNUE_HIDDEN_SIZE = 64;
 
 function createMockGameState() {
     return {
@@ -19,6 +27,123 @@ function createMockPlayers() {
     return [{ id: 'p1' }, { id: 'p3' }];
 }
 
+// Untrained weights with the right shape, so evaluator speed can be measured without a trained network.
+function createRandomNetwork() {
+    const size = 4 + 4 * 4 + NNUE_HIDDEN_SIZE * 2 + NNUE_FEATURE_COUNT * NNUE_HIDDEN_SIZE * 2 + 4 * NNUE_HIDDEN_SIZE + 4 * 4;
+    const view = new DataView(new ArrayBuffer(size));
+    let offset = 0;
+    const random = (range) => Math.floor(Math.random() * (2 * range + 1)) - range;
+
+    'OBNN'.split('').forEach(ch => view.setUint8(offset++, ch.charCodeAt(0)));
+    view.setUint32(offset, 1, true); offset += 4;
+    view.setUint32(offset, NNUE_FEATURE_COUNT, true); offset += 4;
+    view.setUint32(offset, NNUE_HIDDEN_SIZE, true); offset += 4;
+    view.setInt32(offset, 400, true); offset += 4;
+    for (let i = 0; i < NNUE_HIDDEN_SIZE; i++, offset += 2) view.setInt16(offset, random(32), true);
+    for (let i = 0; i < NNUE_FEATURE_COUNT * NNUE_HIDDEN_SIZE; i++, offset += 2) view.setInt16(offset, random(20), true);
+    for (let i = 0; i < 4 * NNUE_HIDDEN_SIZE; i++, offset += 1) view.setInt8(offset, random(127));
+    for (let i = 0; i < 4; i++, offset += 4) view.setInt32(offset, 0, true);
+
+    return new Uint8Array(view.buffer);
+}
+
+// ai.js is a build artifact; one built before a binding was added to NegaMax.cpp lacks it.
+function hasBinding(aiModule, name) {
+    if (typeof aiModule[name] === 'function') return true;
+    console.log(`\nSkipping: public/ai/ai.js has no ${name} binding; rebuild it with \`npm run build:wasm\`.`);
+    return false;
+}
+
+function runEvaluatorComparison(aiModule, jsState, jsPlayers) {
+    if (!hasBinding(aiModule, 'loadNetwork') || !hasBinding(aiModule, 'runEvaluatorBenchmark')) return;
+
+    let weights;
+    if (fs.existsSync(NNUE_WEIGHTS_PATH)) {
+        weights = new Uint8Array(fs.readFileSync(NNUE_WEIGHTS_PATH));
+        console.log('Using NNUE weights from public/ai/nnue.bin');
+    } else {
+        weights = createRandomNetwork();
+        console.log('No public/ai/nnue.bin found, using an untrained network (speed comparison only)');
+    }
+    if (!aiModule.loadNetwork(weights)) {
+        console.error('Failed to load NNUE weights, skipping evaluator comparison.');
+        return;
+    }
+
+    const results = aiModule.runEvaluatorBenchmark(jsState, jsPlayers, BENCHMARK_DEPTH);
+    const evaluatorData = [];
+    for (let i = 0; i < results.length; i++) {
+        const move = results[i].move;
+        evaluatorData.push({
+            Evaluator: results[i].name,
+            'Time (ms)': results[i].timeMs,
+            Nodes: results[i].nodes,
+            NPS: results[i].nps,
+            Score: results[i].score,
+            'Best Move': move.data ? `${move.type} ${move.data.row},${move.data.col}${move.data.orientation ? ' ' + move.data.orientation : ''}` : move.type,
+        });
+    }
+
+    console.log('\n--- Evaluator Benchmark Results ---');
+    console.table(evaluatorData);
+}
+
+function runMctsScaling(aiModule, jsState, jsPlayers) {
+    if (!hasBinding(aiModule, 'runMctsBenchmark')) return;
+
+    const results = aiModule.runMctsBenchmark(jsState, jsPlayers, MCTS_TIME_MS, MCTS_MAX_THREADS);
+    const mctsData = [];
+    for (let i = 0; i < results.length; i++) {
+        mctsData.push({
+            Threads: results[i].threads,
+            'Time (ms)': results[i].timeMs,
+            Playouts: results[i].playouts,
+            'Playouts/s': results[i].playoutsPerSecond,
+            Nodes: results[i].nodes,
+            'Win Rate': results[i].winRate.toFixed(3),
+        });
+    }
+
+    const baseline = mctsData[0]['Playouts/s'];
+    const formattedData = mctsData.map(data => ({
+        ...data,
+        Scaling: baseline > 0 ? `${(data['Playouts/s'] / baseline).toFixed(2)}x` : 'N/A'
+    }));
+
+    console.log(`\n--- MCTS Benchmark Results (${MCTS_TIME_MS} ms per run) ---`);
+    console.table(formattedData);
+    if (results.length === 1) {
+        console.log('Only one thread available; build and run benchmark/mctsScaling.cpp to measure scaling natively.');
+    }
+}
+
+function runAblation(aiModule, jsState, jsPlayers) {
+    const results = aiModule.runAblationBenchmark(jsState, jsPlayers, BENCHMARK_DEPTH);
+
+    // Convert Emscripten::val to a native JS array of objects
+    const benchmarkData = [];
+    for (let i = 0; i < results.length; i++) {
+        benchmarkData.push({
+            Configuration: results[i].name,
+            'Time (ms)': results[i].timeMs,
+            Score: results[i].score,
+        });
+    }
+    
+    // Calculate speedup relative to the vanilla implementation
+    const baselineTime = benchmarkData.find(r => r.Configuration === 'Vanilla NegaMax (None)')['Time (ms)'];
+    
+    const formattedData = benchmarkData.map(data => ({
+        ...data,
+        Speedup: baselineTime > 0 && data['Time (ms)'] > 0 
+            ? `${(Number(baselineTime) / Number(data['Time (ms)'])).toFixed(2)}x` 
+            : 'N/A'
+                })).sort((a, b) => Number(a['Time (ms)']) - Number(b['Time (ms)']));
+
+    console.log('--- Ablation Benchmark Results ---');
+    console.table(formattedData);
+}
+
 async function run() {
     console.log('Loading AI WebAssembly module...');
     const aiModule = await createQuoridorAIModule();
@@ -28,31 +153,9 @@ async function run() {
     const jsPlayers = createMockPlayers();
 
     try {
-        const results = aiModule.runAblationBenchmark(jsState, jsPlayers, BENCHMARK_DEPTH);
-
-        // Convert Emscripten::val to a native JS array of objects
-        const benchmarkData = [];
-        for (let i = 0; i < results.length; i++) {
-            benchmarkData.push({
-                Configuration: results[i].name,
-                'Time (ms)': results[i].timeMs,
-                Score: results[i].score,
-            });
-        }
-        
-        // Calculate speedup relative to the vanilla implementation
-        const baselineTime = benchmarkData.find(r => r.Configuration === 'Vanilla NegaMax (None)')['Time (ms)'];
-        
-        const formattedData = benchmarkData.map(data => ({
-            ...data,
-            Speedup: baselineTime > 0 && data['Time (ms)'] > 0 
-                ? `${(Number(baselineTime) / Number(data['Time (ms)'])).toFixed(2)}x` 
-                : 'N/A'
-                    })).sort((a, b) => Number(a['Time (ms)']) - Number(b['Time (ms)']));
-
-        console.log('--- Ablation Benchmark Results ---');
-        console.table(formattedData);
-
+        if (hasBinding(aiModule, 'runAblationBenchmark')) runAblation(aiModule, jsState, jsPlayers);
+        runEvaluatorComparison(aiModule, jsState, jsPlayers);
+        runMctsScaling(aiModule, jsState, jsPlayers);
     } catch (error) {
         console.error("An error occurred during benchmark execution:", error);
     }
@@ -0,0 +1,129 @@
+// Offline opening book generator.
+// compile with g++ -std=c++17 -O3 -march=native -pthread benchmark/bookgen.cpp -o bookgen
+//
+// Starting from the initial position of every board size and player count, searches each position
+// deeply with multi-PV and stores the best few moves. The positions those moves lead to are searched
+// the same way, up to --plies moves into the game. Transpositions are searched only once.
+//
+// usage: ./bookgen [--depth N] [--lines N] [--plies N] [--boards 5,7,9,11] [--players 2,4]
+//                  [--threads N] [--out public/ai/book.bin]
+
+#include "../client/src/ai/NegaMax.cpp"
+#include "CommandLine.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <condition_variable>
+
+struct BookJob {
+    GameState state;
+    std::vector<Player> players;
+    int ply;
+};
+
+struct GeneratorConfig {
+    int depth = 5;
+    int lines = 2; // Book moves kept per position
+    int plies = 6;
+    std::vector<int> boardSizes = {5, 7, 9, 11};
+    std::vector<int> playerCounts = {2, 4};
+    int threads = 0;
+    std::string outPath = "public/ai/book.bin";
+};
+
+int main(int argc, char** argv) {
+    GeneratorConfig config;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--depth") config.depth = std::atoi(value.c_str());
+        else if (flag == "--lines") config.lines = std::atoi(value.c_str());
+        else if (flag == "--plies") config.plies = std::atoi(value.c_str());
+        else if (flag == "--boards") config.boardSizes = parseIntList(value);
+        else if (flag == "--players") config.playerCounts = parseIntList(value);
+        else if (flag == "--threads") config.threads = std::atoi(value.c_str());
+        else if (flag == "--out") config.outPath = value;
+        else {
+            fprintf(stderr, "Unknown option %s\n", flag.c_str());
+            return 1;
+        }
+    }
+
+    Zobrist::initialize();
+
+    std::deque<BookJob> queue;
+    std::unordered_set<uint64_t> seen;
+    for (int boardSize : config.boardSizes) {
+        for (int numPlayers : config.playerCounts) {
+            BookJob job;
+            job.state = createInitialState(boardSize, numPlayers, job.players);
+            job.ply = 0;
+            seen.insert(Zobrist::bookKey(job.state));
+            queue.push_back(job);
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    int busyWorkers = 0;
+    long long searched = 0;
+    std::vector<Book::Entry> entries;
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Workers take positions from the queue and push the positions after each book move back onto it.
+    // The run ends when the queue is empty and no worker can add to it any more.
+    auto worker = [&]() {
+        while (true) {
+            BookJob job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [&] { return !queue.empty() || busyWorkers == 0; });
+                if (queue.empty()) return;
+                job = queue.front();
+                queue.pop_front();
+                busyWorkers++;
+            }
+
+            transpositionTable.clear();
+            std::vector<RootLine> lines = searchRoot(job.state, job.players, config.depth, config.lines, nullptr);
+            uint64_t key = Zobrist::bookKey(job.state);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t rank = 0; rank < lines.size(); ++rank) {
+                Book::Entry entry;
+                entry.key = key;
+                entry.move = encodeMove(lines[rank].move);
+                entry.weight = static_cast<uint16_t>((lines.size() - rank) * 100);
+                entry.score = lines[rank].score;
+                entries.push_back(entry);
+
+                GameState next = applyMove(job.state, lines[rank].move, job.players);
+                if (job.ply + 1 < config.plies && next.status == "active" && seen.insert(Zobrist::bookKey(next)).second) {
+                    queue.push_back({next, job.players, job.ply + 1});
+                }
+            }
+            busyWorkers--;
+            if (++searched % 10 == 0) {
+                printf("\r%lld positions searched, %zu queued", searched, queue.size());
+                fflush(stdout);
+            }
+            wakeUp.notify_all();
+        }
+    };
+
+    int threads = config.threads > 0 ? config.threads : availableThreads();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& thread : pool) thread.join();
+
+    long long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count();
+    if (!Book::write(config.outPath, entries)) {
+        fprintf(stderr, "\nFailed to write %s\n", config.outPath.c_str());
+        return 1;
+    }
+    printf("\r%lld positions searched in %.1f s, %zu entries written to %s\n", searched, elapsed / 1000.0, entries.size(), config.outPath.c_str());
+    return 0;
+}
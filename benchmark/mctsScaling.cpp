@@ -0,0 +1,81 @@
+// Native MCTS thread scaling benchmark.
+// compile with g++ -std=c++17 -O3 -march=native -pthread benchmark/mctsScaling.cpp -o mctsScaling
+//
+// Searches the opening position with searchMcts on 1, 2, 4, ... threads up to --threads (every core
+// by default, never more than there are cores) and reports playouts per second against the
+// single-threaded run. The default ai.js is built without -pthread and can only measure one thread;
+// this runs the same engine natively.
+//
+// usage: ./mctsScaling [--time MS] [--threads N] [--runs N] [--board N] [--players N]
+
+#include "../client/src/ai/NegaMax.cpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+struct ScalingConfig {
+    int timeMs = 1000;
+    int maxThreads = 0;
+    int runs = 3;       // Searches per thread count; the figures are summed over all of them
+    int boardSize = 9;
+    int numPlayers = 2;
+};
+
+int main(int argc, char** argv) {
+    ScalingConfig config;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        int value = std::atoi(argv[i + 1]);
+        if (flag == "--time") config.timeMs = value;
+        else if (flag == "--threads") config.maxThreads = value;
+        else if (flag == "--runs") config.runs = value;
+        else if (flag == "--board") config.boardSize = value;
+        else if (flag == "--players") config.numPlayers = value;
+        else {
+            fprintf(stderr, "Unknown option %s\n", flag.c_str());
+            return 1;
+        }
+    }
+    if (config.boardSize < 3 || config.boardSize > Zobrist::MAX_BOARD_SIZE || (config.numPlayers != 2 && config.numPlayers != 4) ||
+        config.timeMs < 1 || config.runs < 1) {
+        fprintf(stderr, "Invalid configuration\n");
+        return 1;
+    }
+
+    Zobrist::initialize();
+    std::vector<Player> players;
+    GameState state = createInitialState(config.boardSize, config.numPlayers, players);
+
+    // searchMcts never runs more threads than there are cores.
+    int threadLimit = std::min(config.maxThreads > 0 ? config.maxThreads : availableThreads(), availableThreads());
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < threadLimit; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(threadLimit);
+
+    printf("MCTS scaling: %dx%d board, %d players, %d x %d ms per thread count, %d cores\n\n",
+           config.boardSize, config.boardSize, config.numPlayers, config.runs, config.timeMs, availableThreads());
+    printf("%8s %12s %14s %12s %10s %12s %9s\n", "threads", "playouts", "playouts/s", "nodes", "win rate", "tree depth", "scaling");
+
+    double baseline = 0.0;
+    for (int threads : threadCounts) {
+        long long playouts = 0, timeMs = 0, nodes = 0;
+        double winRate = 0.0, depth = 0.0;
+        for (int run = 0; run < config.runs; ++run) {
+            MctsResult result = searchMcts(state, players, config.timeMs, threads, 0);
+            playouts += result.playouts;
+            timeMs += result.timeMs;
+            nodes += result.nodes;
+            winRate += result.winRate;
+            depth += result.averageDepth * result.playouts;
+        }
+
+        double rate = timeMs > 0 ? playouts * 1000.0 / timeMs : 0.0;
+        if (baseline == 0.0) baseline = rate;
+        printf("%8d %12lld %14.0f %12lld %10.3f %12.2f %8.2fx\n", threads, playouts / config.runs, rate, nodes / config.runs,
+               winRate / config.runs, playouts > 0 ? depth / playouts : 0.0, baseline > 0.0 ? rate / baseline : 0.0);
+    }
+    if (availableThreads() == 1) {
+        printf("\nOnly one core available; run on a multi-core machine to measure scaling.\n");
+    }
+    return 0;
+}
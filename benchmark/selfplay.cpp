@@ -0,0 +1,319 @@
+// Native self-play match runner for engine regression and tuning.
+// compile with g++ -std=c++17 -O3 -march=native -pthread benchmark/selfplay.cpp -o selfplay
+//
+// Plays games between two engine configurations (A and B) in parallel on every core, cycling through
+// board sizes and player counts. Games come in pairs that share a random opening with the seats
+// swapped, so neither side profits from a lucky opening or from moving first.
+//
+// usage: ./selfplay [--games N] [--threads N] [--boards 5,7,9,11] [--players 2,4]
+//                   [--a SPEC] [--b SPEC] [--opening-plies N] [--max-plies N]
+//                   [--nnue weights.bin] [--book book.bin] [--out games.bin] [--seed N]
+//
+// SPEC is "negamax:depth=3,eval=heuristic" or "mcts:time=200,threads=1"; add "book=off" to ignore the book.
+//
+// Game record file (little-endian):
+//   char   magic[4]      "OBGR"
+//   uint8  version       1
+//   then one record per game:
+//     uint32 gameIndex
+//     uint8  boardSize
+//     uint8  numPlayers
+//     uint8  seatsForB     bit i set when seat i was played by configuration B
+//     uint8  winnerSeat    0xFF for a draw (ply limit reached)
+//     uint8  openingPlies  leading random moves
+//     uint16 plyCount
+//     uint16 moves[plyCount]  (kind << 8) | (row << 4) | col; kind 0 pawn, 1 horizontal wall, 2 vertical wall, 3 pass
+
+#include "../client/src/ai/NegaMax.cpp"
+#include "CommandLine.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+// --- CONFIGURATION ---
+struct EngineConfig {
+    std::string spec;
+    SearchOptions options;
+};
+
+struct MatchConfig {
+    int games = 200;
+    int threads = 0;
+    std::vector<int> boardSizes = {5, 7, 9, 11};
+    std::vector<int> playerCounts = {2, 4};
+    EngineConfig engines[2];
+    int openingPlies = 4;   // Upper bound; each pair draws a count in [0, openingPlies]
+    int maxPlies = 300;     // Longer games are scored as draws
+    std::string nnuePath;
+    std::string bookPath;
+    std::string outPath = "selfplay_games.bin";
+    unsigned int seed = 1;
+};
+
+struct EngineStats {
+    long long moves = 0;
+    long long timeUs = 0;
+    long long nodes = 0;     // Negamax nodes, or playouts for MCTS
+    double depthSum = 0.0;   // Negamax: depth reached; MCTS: average tree depth of the playouts
+    long long bookMoves = 0; // Not included in the search averages
+};
+
+struct GameRecord {
+    uint32_t gameIndex;
+    uint8_t boardSize;
+    uint8_t numPlayers;
+    uint8_t seatsForB;
+    uint8_t winnerSeat;
+    uint8_t openingPlies;
+    std::vector<uint16_t> moves;
+};
+
+const uint8_t DRAW_SEAT = 0xFF;
+const uint16_t PASS_MOVE = 3 << 8; // A player boxed in by pawns with no walls left
+
+bool parseEngineSpec(const std::string& spec, EngineConfig& config) {
+    config.spec = spec;
+    config.options = SearchOptions();
+    config.options.threads = 1;
+
+    std::string name = spec.substr(0, spec.find(':'));
+    if (name == "mcts") config.options.engine = MCTS_ENGINE;
+    else if (name != "negamax") return false;
+
+    if (spec.find(':') == std::string::npos) return true;
+    std::stringstream params(spec.substr(spec.find(':') + 1));
+    std::string param;
+    while (std::getline(params, param, ',')) {
+        size_t eq = param.find('=');
+        if (eq == std::string::npos) return false;
+        std::string key = param.substr(0, eq);
+        std::string value = param.substr(eq + 1);
+        if (key == "depth") config.options.depth = std::atoi(value.c_str());
+        else if (key == "time") config.options.timeMs = std::atoi(value.c_str());
+        else if (key == "threads") config.options.threads = std::atoi(value.c_str());
+        else if (key == "eval") config.options.evaluator = value == "nnue" ? NNUE_EVAL : HEURISTIC_EVAL;
+        else if (key == "book") config.options.useBook = value != "off";
+        else return false;
+    }
+    return true;
+}
+
+// --- GAME LOOP ---
+// Returns the winning seat, or DRAW_SEAT when the ply limit is reached.
+uint8_t playGame(const MatchConfig& match, int gameIndex, GameRecord& record, EngineStats stats[2]) {
+    int pairIndex = gameIndex / 2;
+    int combos = static_cast<int>(match.boardSizes.size() * match.playerCounts.size());
+    int combo = pairIndex % combos;
+    int boardSize = match.boardSizes[combo % match.boardSizes.size()];
+    int numPlayers = match.playerCounts[combo / match.boardSizes.size()];
+
+    // Seats alternate between the configurations; the second game of a pair swaps them.
+    bool swapped = (gameIndex % 2) == 1;
+    record.seatsForB = 0;
+    for (int seat = 0; seat < numPlayers; ++seat) {
+        if ((seat % 2 == 1) != swapped) record.seatsForB |= 1 << seat;
+    }
+
+    std::vector<Player> players;
+    GameState state = createInitialState(boardSize, numPlayers, players);
+    record.gameIndex = static_cast<uint32_t>(gameIndex);
+    record.boardSize = static_cast<uint8_t>(boardSize);
+    record.numPlayers = static_cast<uint8_t>(numPlayers);
+    record.moves.clear();
+
+    // Both games of a pair draw the same opening.
+    std::mt19937 openingRng(match.seed * 7919u + static_cast<unsigned int>(pairIndex));
+    int openingPlies = static_cast<int>(openingRng() % (match.openingPlies + 1));
+    record.openingPlies = static_cast<uint8_t>(openingPlies);
+
+    // Each engine keeps its own transposition table for the game, swapped in around its searches,
+    // so neither reuses the other's entries or hash moves.
+    std::unordered_map<uint64_t, TTEntry> engineTables[2];
+    for (int ply = 0; ply < match.maxPlies && state.status != "ended"; ++ply) {
+        std::vector<Move> moves = generateAndOrderMoves(state, players);
+        if (moves.empty()) {
+            record.moves.push_back(PASS_MOVE);
+            state = switchTurn(state);
+            continue;
+        }
+
+        Move move;
+        if (ply < openingPlies) {
+            move = moves[openingRng() % moves.size()];
+        } else {
+            int engineIndex = (record.seatsForB >> state.playerTurnIndex) & 1;
+            const SearchOptions& options = match.engines[engineIndex].options;
+            EngineStats& engineStats = stats[engineIndex];
+            auto startTime = std::chrono::high_resolution_clock::now();
+            Move bookMove = options.useBook ? probeBook(state, players) : Move{};
+
+            if (!bookMove.type.empty()) {
+                move = bookMove;
+                engineStats.bookMoves++;
+            } else if (options.engine == MCTS_ENGINE) {
+                MctsResult result = searchMcts(state, players, options.timeMs, options.threads, 0);
+                move = result.bestMove;
+                engineStats.nodes += result.playouts;
+                engineStats.depthSum += result.averageDepth;
+            } else {
+                GameState searchState = state;
+                selectEvaluator(searchState, options.evaluator);
+                int depthReached = 0;
+                transpositionTable.swap(engineTables[engineIndex]);
+                std::vector<RootLine> lines = searchRoot(searchState, players, options.depth, 1,
+                                                         [&depthReached](const SearchInfo& info) { depthReached = info.depth; });
+                transpositionTable.swap(engineTables[engineIndex]);
+                move = lines.empty() ? moves[0] : lines[0].move;
+                engineStats.nodes += nodesSearched;
+                engineStats.depthSum += depthReached;
+            }
+
+            if (bookMove.type.empty()) {
+                auto endTime = std::chrono::high_resolution_clock::now();
+                engineStats.timeUs += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+                engineStats.moves++;
+            }
+        }
+
+        if (move.type == "resign") break;
+        record.moves.push_back(encodeMove(move));
+        state = applyMove(state, move, players);
+    }
+
+    if (state.status != "ended") return DRAW_SEAT;
+    return static_cast<uint8_t>(std::distance(state.activePlayerIds.begin(),
+        std::find(state.activePlayerIds.begin(), state.activePlayerIds.end(), state.winner)));
+}
+
+// --- RESULTS ---
+// Elo difference of A over B with a 95% confidence interval, from the per-game score distribution.
+void printElo(int wins, int draws, int losses) {
+    int games = wins + draws + losses;
+    if (games == 0) return;
+    double score = (wins + 0.5 * draws) / games;
+    double variance = (wins * std::pow(1.0 - score, 2) + draws * std::pow(0.5 - score, 2) + losses * std::pow(score, 2)) / games;
+    double margin = 1.96 * std::sqrt(variance / games);
+
+    auto elo = [](double s) {
+        s = std::min(std::max(s, 1e-6), 1.0 - 1e-6);
+        return -400.0 * std::log10(1.0 / s - 1.0);
+    };
+    printf("Elo (A - B): %+.1f  [%+.1f, %+.1f] (95%%)\n", elo(score), elo(score - margin), elo(score + margin));
+}
+
+void printEngineStats(const char* label, const EngineConfig& engine, const EngineStats& stats) {
+    double moves = static_cast<double>(std::max(1LL, stats.moves));
+    double nps = stats.timeUs > 0 ? stats.nodes * 1000000.0 / stats.timeUs : 0.0;
+    bool isMcts = engine.options.engine == MCTS_ENGINE;
+    printf("%s %-36s moves %8lld  book %6lld  %s/s %10.0f  avg %s %5.2f  avg time/move %8.3f ms\n",
+           label, engine.spec.c_str(), stats.moves, stats.bookMoves, isMcts ? "playouts" : "nodes   ", nps,
+           isMcts ? "tree depth" : "depth     ", stats.depthSum / moves, stats.timeUs / moves / 1000.0);
+}
+
+void writeRecord(std::ofstream& out, const GameRecord& record) {
+    auto put = [&out](const void* data, size_t size) { out.write(static_cast<const char*>(data), size); };
+    uint16_t plyCount = static_cast<uint16_t>(record.moves.size());
+    put(&record.gameIndex, sizeof(record.gameIndex));
+    put(&record.boardSize, 1);
+    put(&record.numPlayers, 1);
+    put(&record.seatsForB, 1);
+    put(&record.winnerSeat, 1);
+    put(&record.openingPlies, 1);
+    put(&plyCount, sizeof(plyCount));
+    put(record.moves.data(), record.moves.size() * sizeof(uint16_t));
+}
+
+int main(int argc, char** argv) {
+    MatchConfig match;
+    parseEngineSpec("negamax:depth=2", match.engines[0]);
+    parseEngineSpec("negamax:depth=2", match.engines[1]);
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--games") match.games = std::atoi(value.c_str());
+        else if (flag == "--threads") match.threads = std::atoi(value.c_str());
+        else if (flag == "--boards") match.boardSizes = parseIntList(value);
+        else if (flag == "--players") match.playerCounts = parseIntList(value);
+        else if (flag == "--opening-plies") match.openingPlies = std::atoi(value.c_str());
+        else if (flag == "--max-plies") match.maxPlies = std::atoi(value.c_str());
+        else if (flag == "--nnue") match.nnuePath = value;
+        else if (flag == "--book") match.bookPath = value;
+        else if (flag == "--out") match.outPath = value;
+        else if (flag == "--seed") match.seed = static_cast<unsigned int>(std::atoi(value.c_str()));
+        else if ((flag == "--a" || flag == "--b") && parseEngineSpec(value, match.engines[flag == "--a" ? 0 : 1])) continue;
+        else {
+            fprintf(stderr, "Unknown or invalid option %s %s\n", flag.c_str(), value.c_str());
+            return 1;
+        }
+    }
+    if (match.boardSizes.empty() || match.playerCounts.empty()) {
+        fprintf(stderr, "At least one board size and player count is required\n");
+        return 1;
+    }
+
+    Zobrist::initialize();
+    if (!match.nnuePath.empty() && !Nnue::loadNetworkFile(match.nnuePath)) {
+        fprintf(stderr, "Failed to load NNUE weights from %s\n", match.nnuePath.c_str());
+        return 1;
+    }
+    if (!match.bookPath.empty() && !Book::loadFile(match.bookPath)) {
+        fprintf(stderr, "Failed to load opening book from %s\n", match.bookPath.c_str());
+        return 1;
+    }
+
+    int threads = match.threads > 0 ? match.threads : availableThreads();
+    printf("Self-play: %d games on %d threads\n  A: %s\n  B: %s\n", match.games, threads,
+           match.engines[0].spec.c_str(), match.engines[1].spec.c_str());
+
+    std::ofstream out(match.outPath, std::ios::binary);
+    out.write("OBGR", 4);
+    out.put(1);
+
+    std::mutex resultsMutex;
+    std::atomic<int> nextGame(0);
+    int wins = 0, draws = 0, losses = 0, finished = 0;
+    EngineStats totals[2];
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    auto worker = [&]() {
+        GameRecord record;
+        for (int game = nextGame.fetch_add(1); game < match.games; game = nextGame.fetch_add(1)) {
+            EngineStats stats[2];
+            record.winnerSeat = playGame(match, game, record, stats);
+
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            if (record.winnerSeat == DRAW_SEAT) draws++;
+            else if ((record.seatsForB >> record.winnerSeat) & 1) losses++;
+            else wins++;
+            for (int e = 0; e < 2; ++e) {
+                totals[e].moves += stats[e].moves;
+                totals[e].timeUs += stats[e].timeUs;
+                totals[e].nodes += stats[e].nodes;
+                totals[e].depthSum += stats[e].depthSum;
+                totals[e].bookMoves += stats[e].bookMoves;
+            }
+            writeRecord(out, record);
+
+            if (++finished % 10 == 0 || finished == match.games) {
+                printf("\r%d/%d games  A +%d =%d -%d", finished, match.games, wins, draws, losses);
+                fflush(stdout);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& thread : pool) thread.join();
+
+    long long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count();
+    printf("\n\nFinished in %.1f s, records written to %s\n", elapsed / 1000.0, match.outPath.c_str());
+    printf("A wins %d, draws %d, B wins %d\n", wins, draws, losses);
+    printElo(wins, draws, losses);
+    printEngineStats("A:", match.engines[0], totals[0]);
+    printEngineStats("B:", match.engines[1], totals[1]);
+    return 0;
+}
@@ -0,0 +1,203 @@
+// Server load benchmark: move validation throughput and memory per room, comparing the previous
+// JS path (GameLogic.applyMove on a deep-cloned state, full state copy in the history every ply)
+// with GameManager (C++ rules core, in-place state, compact move log). The table names the build
+// of the rules core in use: the native addon, or the WASM module.
+// Each implementation runs in its own child process, so its resident memory is measured from a clean
+// start; RSS covers the native or WASM memory of the rules core, which the JS heap figures miss.
+// run with: npm run benchmark:server
+import { fork } from 'child_process';
+import { fileURLToPath } from 'url';
+import * as GameLogic from '../common/GameLogic.js';
+import GameManager from '../server/GameManager.js';
+import { rulesBackend } from '../server/RulesEngine.js';
+import { ALL_PLAYERS } from '../client/src/config/gameConfig.js';
+
+// --- Configuration ---
+const ROOMS = 500;
+const MAX_REQUESTS_PER_ROOM = 200;
+const WALL_REQUEST_RATE = 0.3; // Share of requests that try a random (possibly illegal) wall
+const SEED = 12345;
+
+const nullEmitter = { emit: () => {} };
+
+// The move path GameManager used before the rules moved to C++.
+class LegacyGameManager {
+    constructor(emitter, config) {
+        this.emitter = emitter;
+        this.config = config;
+        this.players = config.players;
+        this.history = [];
+        this.gameState = GameLogic.createInitialState(config);
+        this.gameState.availablePawnMoves = GameLogic.calculateLegalPawnMoves(
+            this.gameState.pawnPositions, this.gameState.placedWalls, this.players,
+            this.gameState.activePlayerIds, this.gameState.playerTurnIndex, config.boardSize
+        );
+        this.history.push(JSON.parse(JSON.stringify(this.gameState)));
+    }
+
+    handleMoveRequest(move) {
+        if (this.gameState.status !== 'active') return false;
+        this.gameState.drawOfferFrom = null;
+        const newGameState = GameLogic.applyMove(this.gameState, move, this.players, this.config);
+        if (!newGameState) return false;
+        this.gameState = newGameState;
+        this.history.push(JSON.parse(JSON.stringify(this.gameState)));
+        this.emitter.emit('game-state-updated', this.gameState);
+        return true;
+    }
+
+    destroy() {}
+}
+
+function createConfig(numPlayers) {
+    return {
+        numPlayers,
+        players: numPlayers === 2 ? [ALL_PLAYERS[0], ALL_PLAYERS[2]] : ALL_PLAYERS.slice(0, 4),
+        wallsPerPlayer: numPlayers === 2 ? 10 : 5,
+        timePerPlayer: 5 * 60 * 1000,
+        boardSize: 9,
+    };
+}
+
+function createRandom(seed) {
+    return () => {
+        seed = (seed + 0x6D2B79F5) | 0;
+        let t = Math.imul(seed ^ (seed >>> 15), 1 | seed);
+        t = (t + Math.imul(t ^ (t >>> 7), 61 | t)) ^ t;
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    };
+}
+
+// Plays a random game and returns every request a client sent, so both implementations replay
+// exactly the same traffic, illegal wall attempts included.
+function generateRequests(config, random) {
+    let state = GameLogic.createInitialState(config);
+    state.availablePawnMoves = GameLogic.calculateLegalPawnMoves(
+        state.pawnPositions, state.placedWalls, config.players,
+        state.activePlayerIds, state.playerTurnIndex, config.boardSize
+    );
+    const requests = [];
+
+    while (state.status === 'active' && requests.length < MAX_REQUESTS_PER_ROOM) {
+        const canWall = state.wallsLeft[state.playerTurn] > 0;
+        let move;
+        if (canWall && (random() < WALL_REQUEST_RATE || state.availablePawnMoves.length === 0)) {
+            const row = Math.floor(random() * (config.boardSize - 1));
+            const col = Math.floor(random() * (config.boardSize - 1));
+            move = { type: 'wall', data: { row, col, orientation: random() < 0.5 ? 'horizontal' : 'vertical' } };
+        } else if (state.availablePawnMoves.length > 0) {
+            const target = state.availablePawnMoves[Math.floor(random() * state.availablePawnMoves.length)];
+            move = { type: 'cell', data: { row: target.row, col: target.col } };
+        } else {
+            break;
+        }
+        requests.push(move);
+        state = GameLogic.applyMove(state, move, config.players, config) || state;
+    }
+    return requests;
+}
+
+const SCENARIOS = {
+    legacy: { label: 'JS rules + full state history', Manager: LegacyGameManager },
+    current: { label: `C++ rules (${rulesBackend}) + move log`, Manager: GameManager },
+};
+
+function usedMemory() {
+    if (global.gc) global.gc();
+    const usage = process.memoryUsage();
+    return { heap: usage.heapUsed + usage.external, rss: usage.rss };
+}
+
+function createWorkload() {
+    const random = createRandom(SEED);
+    const configs = [];
+    const requestStreams = [];
+    for (let i = 0; i < ROOMS; i++) {
+        const config = createConfig(i % 2 === 0 ? 2 : 4);
+        configs.push(config);
+        requestStreams.push(generateRequests(config, random));
+    }
+    return { configs, requestStreams };
+}
+
+function runScenario({ label, Manager }, configs, requestStreams) {
+    const memoryBefore = usedMemory();
+    const rooms = configs.map(config => new Manager(nullEmitter, config));
+
+    // Rooms take turns, one request each, like interleaved traffic on a busy server
+    let validations = 0;
+    let accepted = 0;
+    const decisions = requestStreams.map(stream => new Array(stream.length)); // Per request, for the agreement check
+    const startTime = performance.now();
+    for (let ply = 0; ply < MAX_REQUESTS_PER_ROOM; ply++) {
+        for (let i = 0; i < rooms.length; i++) {
+            const move = requestStreams[i][ply];
+            if (!move) continue;
+            validations++;
+            decisions[i][ply] = rooms[i].handleMoveRequest(move);
+            if (decisions[i][ply]) accepted++;
+        }
+    }
+    const elapsedMs = performance.now() - startTime;
+    const memoryAfter = usedMemory();
+    const kbPerRoom = (bytes) => (bytes / rooms.length / 1024).toFixed(1);
+
+    rooms.forEach(room => room.destroy());
+    return {
+        decisions,
+        Implementation: label,
+        Validations: validations,
+        Accepted: accepted,
+        'Time (ms)': elapsedMs.toFixed(0),
+        'Validations/s': Math.round(validations / (elapsedMs / 1000)),
+        'JS heap/room (KB)': kbPerRoom(memoryAfter.heap - memoryBefore.heap),
+        'RSS/room (KB)': kbPerRoom(memoryAfter.rss - memoryBefore.rss),
+    };
+}
+
+// Runs one scenario in a fresh process and resolves with its result row.
+function runInChild(name) {
+    return new Promise((resolve, reject) => {
+        const child = fork(fileURLToPath(import.meta.url), ['--scenario', name], { execArgv: ['--expose-gc'] });
+        child.on('message', resolve);
+        child.on('error', reject);
+        child.on('exit', code => { if (code !== 0) reject(new Error(`${name} scenario exited with code ${code}`)); });
+    });
+}
+
+async function run() {
+    const { requestStreams } = createWorkload();
+    console.log(`Replaying ${requestStreams.reduce((sum, r) => sum + r.length, 0)} move requests across ${ROOMS} rooms (2 and 4 players)...\n`);
+
+    const results = [await runInChild('legacy'), await runInChild('current')];
+
+    const baseline = results[0];
+    const formattedData = results.map(({ decisions, ...data }) => ({
+        ...data,
+        Speedup: `${(data['Validations/s'] / baseline['Validations/s']).toFixed(2)}x`,
+    }));
+
+    console.log('--- Server Load Benchmark Results ---');
+    console.table(formattedData);
+    // Compares every request's accept/reject decision, not just the totals.
+    const mismatches = [];
+    results[0].decisions.forEach((roomDecisions, room) => {
+        roomDecisions.forEach((decision, ply) => {
+            if (decision !== results[1].decisions[room][ply]) mismatches.push({ room, ply, move: requestStreams[room][ply], legacy: decision });
+        });
+    });
+    if (mismatches.length > 0) {
+        console.error(`Implementations disagree on ${mismatches.length} requests, first:`, JSON.stringify(mismatches[0]));
+        process.exitCode = 1;
+    } else {
+        console.log('Both implementations made the same decision on every request.');
+    }
+}
+
+const scenarioIndex = process.argv.indexOf('--scenario');
+if (scenarioIndex !== -1) {
+    const { configs, requestStreams } = createWorkload();
+    process.send(runScenario(SCENARIOS[process.argv[scenarioIndex + 1]], configs, requestStreams));
+} else {
+    run();
+}
@@ -0,0 +1,132 @@
+// Opening book: a sorted array of fixed-size records, looked up by binary search.
+//
+// File layout (little-endian):
+//   char    magic[4]     "OBBK"
+//   uint32  version      1
+//   uint32  entryCount
+//   uint32  reserved     keeps the entries 8-byte aligned
+//   Entry   entries[entryCount], sorted by key, then by weight (highest first)
+//
+// Keys are the position's Zobrist hash combined with a board size key (see Zobrist::bookKey), so
+// equal placements on different board sizes do not collide. Natively the file is mmapped and read in
+// place; in WASM the bytes are copied into the module's memory once.
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Book {
+    struct Entry {
+        uint64_t key;
+        uint16_t move;   // Encoded with encodeMove()
+        uint16_t weight; // Relative preference among the moves of one position
+        int32_t score;   // Search score from the generator, for inspection
+    };
+    static_assert(sizeof(Entry) == 16, "Book entries must be 16 bytes");
+
+    const uint32_t FILE_VERSION = 1;
+    const size_t HEADER_SIZE = 16;
+
+    inline const Entry* entries = nullptr;
+    inline size_t entryCount = 0;
+    inline std::vector<Entry> storage; // Owns the entries when they were copied in
+#ifndef __EMSCRIPTEN__
+    inline void* mapping = nullptr;
+    inline size_t mappingSize = 0;
+#endif
+
+    inline void unload() {
+#ifndef __EMSCRIPTEN__
+        if (mapping) munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+#endif
+        storage.clear();
+        entries = nullptr;
+        entryCount = 0;
+    }
+
+    // Checks the header and returns the number of entries, or -1 if the data is not a valid book.
+    inline long long validate(const uint8_t* data, size_t size) {
+        if (size < HEADER_SIZE || std::memcmp(data, "OBBK", 4) != 0) return -1;
+        uint32_t version, count;
+        std::memcpy(&version, data + 4, sizeof(version));
+        std::memcpy(&count, data + 8, sizeof(count));
+        if (version != FILE_VERSION || size != HEADER_SIZE + static_cast<size_t>(count) * sizeof(Entry)) return -1;
+        return count;
+    }
+
+    inline bool load(const uint8_t* data, size_t size) {
+        unload();
+        long long count = validate(data, size);
+        if (count < 0) return false;
+        storage.resize(static_cast<size_t>(count));
+        std::memcpy(storage.data(), data + HEADER_SIZE, storage.size() * sizeof(Entry));
+        entries = storage.data();
+        entryCount = storage.size();
+        return true;
+    }
+
+#ifndef __EMSCRIPTEN__
+    inline bool loadFile(const std::string& path) {
+        unload();
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(HEADER_SIZE)) {
+            close(fd);
+            return false;
+        }
+        void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) return false;
+
+        long long count = validate(static_cast<const uint8_t*>(data), info.st_size);
+        if (count < 0) {
+            munmap(data, info.st_size);
+            return false;
+        }
+        mapping = data;
+        mappingSize = info.st_size;
+        entries = reinterpret_cast<const Entry*>(static_cast<const uint8_t*>(data) + HEADER_SIZE);
+        entryCount = static_cast<size_t>(count);
+        return true;
+    }
+#endif
+
+    inline bool loaded() {
+        return entryCount > 0;
+    }
+
+    // Returns the highest weighted entry for the key, or nullptr. O(log n).
+    inline const Entry* probe(uint64_t key) {
+        const Entry* end = entries + entryCount;
+        const Entry* it = std::lower_bound(entries, end, key, [](const Entry& entry, uint64_t k) { return entry.key < k; });
+        return (it != end && it->key == key) ? it : nullptr;
+    }
+
+    // Writes entries (any order) as a book file; used by the generator.
+    inline bool write(const std::string& path, std::vector<Entry> bookEntries) {
+        std::sort(bookEntries.begin(), bookEntries.end(), [](const Entry& a, const Entry& b) {
+            return a.key != b.key ? a.key < b.key : a.weight > b.weight;
+        });
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        uint32_t header[4] = {0, FILE_VERSION, static_cast<uint32_t>(bookEntries.size()), 0};
+        std::memcpy(header, "OBBK", 4);
+        bool ok = std::fwrite(header, sizeof(header), 1, file) == 1 &&
+                  std::fwrite(bookEntries.data(), sizeof(Entry), bookEntries.size(), file) == bookEntries.size();
+        return std::fclose(file) == 0 && ok;
+    }
+}
@@ -1,4 +1,5 @@
-// compile with em++ client/src/ai/NegaMax.cpp --bind -o public/ai/ai.js -O3 -s WASM=1 -s MODULARIZE=1 -s EXPORT_ES6=1
+// compile with em++ client/src/ai/NegaMax.cpp --bind -o public/ai/ai.js -O3 -msimd128 -s WASM=1 -s MODULARIZE=1 -s EXPORT_ES6=1 -s ALLOW_MEMORY_GROWTH=1
+// add -pthread -s PTHREAD_POOL_SIZE=4 to let the MCTS engine use several threads (the page must be cross-origin isolated)
 
 #include <iostream>
 #include <vector>
@@ -13,15 +14,31 @@
 #include <chrono>
 #include <unordered_map>
 #include <climits>
+#include <atomic>
+#include <thread>
+#include <memory>
 
+#ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
+#endif
+
+#include "Nnue.h"
+#include "Book.h"
 
 // --- CONFIGURATION ---
 const double PATH_SCORE_BASE = 2.0;
 const int MAX_EXPECTED_PATH = 16;
 
+// MCTS engine
+const double MCTS_EXPLORATION = 1.41;
+const int MCTS_EXPANSION_VISITS = 3;      // A leaf is expanded once it has been visited this many times
+const int MCTS_MAX_PLAYOUT_PLIES = 200;   // Longer playouts are decided by the shortest-path race
+const int MCTS_WALL_PROBABILITY = 25;     // Percent of playout plies that try a random wall first
+const int MCTS_GREEDY_PROBABILITY = 80;   // Percent of playout pawn moves that follow the shortest path
+const uint32_t MCTS_NODE_CAPACITY = 1 << 20; // Per calling thread; the arena is kept between searches
+
 // --- DATA STRUCTURES ---
 struct PawnPos { 
     int row; 
@@ -59,6 +76,33 @@ struct Move {
     }
 };
 
+// Compact move for MCTS nodes, game records and the opening book. kind: 0 pawn move, 1 horizontal wall, 2 vertical wall.
+struct PackedMove {
+    int8_t kind;
+    int8_t row;
+    int8_t col;
+};
+
+PackedMove packMove(const Move& move) {
+    if (move.type == "cell") return {0, static_cast<int8_t>(move.pos.row), static_cast<int8_t>(move.pos.col)};
+    return {static_cast<int8_t>(move.wall.orientation == "horizontal" ? 1 : 2), static_cast<int8_t>(move.wall.row), static_cast<int8_t>(move.wall.col)};
+}
+
+Move unpackMove(const PackedMove& packed) {
+    if (packed.kind == 0) return {"cell", {packed.row, packed.col}, {}};
+    return {"wall", {}, {packed.row, packed.col, packed.kind == 1 ? "horizontal" : "vertical"}};
+}
+
+// 16-bit form used in files: (kind << 8) | (row << 4) | col.
+uint16_t encodeMove(const Move& move) {
+    PackedMove packed = packMove(move);
+    return static_cast<uint16_t>((packed.kind << 8) | (packed.row << 4) | packed.col);
+}
+
+Move decodeMove(uint16_t encoded) {
+    return unpackMove({static_cast<int8_t>(encoded >> 8), static_cast<int8_t>((encoded >> 4) & 0xF), static_cast<int8_t>(encoded & 0xF)});
+}
+
 struct Player { 
     std::string id; 
     std::function<bool(int, int, int)> goalCondition; 
@@ -75,6 +119,21 @@ struct GameState {
     std::string status = "active"; 
     std::string winner = ""; 
     uint64_t zobristHash = 0; // Zobrist hash for the current state
+    bool useNnue = false; // Evaluate with the network; the accumulator is then kept up to date by applyMove
+    Nnue::Accumulator accumulator;
+};
+
+// --- SEARCH OPTIONS ---
+enum EvaluatorType { HEURISTIC_EVAL, NNUE_EVAL };
+enum EngineType { NEGAMAX_ENGINE, MCTS_ENGINE };
+struct SearchOptions {
+    int depth = 4;
+    int multiPV = 1;
+    EvaluatorType evaluator = HEURISTIC_EVAL;
+    EngineType engine = NEGAMAX_ENGINE;
+    int timeMs = 1000; // MCTS time budget
+    int threads = 0;   // MCTS worker threads, 0 uses every available core
+    bool useBook = true; // Play from the opening book when the position is in it
 };
 
 // --- TRANSPOSITION TABLE (TT) IMPLEMENTATION ---
@@ -83,8 +142,31 @@ struct TTEntry {
     int score;
     int depth;
     TTFlag flag;
+    Move bestMove; // type is empty when no move was searched from this node
+};
+// Per thread, so native tools (benchmark/selfplay.cpp) can run independent searches in parallel.
+thread_local std::unordered_map<uint64_t, TTEntry> transpositionTable;
+
+// Nodes visited by negamax since the counter was last reset; used for NPS reporting.
+thread_local long long nodesSearched = 0;
+
+// --- SEARCH INFO ---
+// One line of per-iteration search output, as streamed to the analysis view.
+struct SearchInfo {
+    int depth;
+    int multiPV; // 1-based index of this line among the top-K root moves
+    int score;
+    long long nodes;
+    long long nps;
+    long long timeMs;
+    std::vector<Move> pv;
+};
+
+struct RootLine {
+    Move move;
+    int score;
+    std::vector<Move> pv;
 };
-std::unordered_map<uint64_t, TTEntry> transpositionTable;
 
 // Zobrist Hashing for state-caching
 namespace Zobrist {
@@ -94,6 +176,8 @@ namespace Zobrist {
     std::vector<std::vector<uint64_t>> h_wallKeys;
     std::vector<std::vector<uint64_t>> v_wallKeys;
     std::vector<uint64_t> turnKeys;
+    uint64_t nnueKey; // Keeps network and heuristic scores apart in the shared TT
+    std::vector<uint64_t> boardSizeKeys;
 
     void initialize() {
         std::mt19937_64 gen(0xBADF00D); // Fixed seed for determinism
@@ -120,8 +204,15 @@ namespace Zobrist {
         for(int p = 0; p < MAX_PLAYERS; ++p) {
             turnKeys[p] = gen();
         }
+        nnueKey = gen();
+
+        boardSizeKeys.resize(MAX_BOARD_SIZE + 1);
+        for (int size = 0; size <= MAX_BOARD_SIZE; ++size) {
+            boardSizeKeys[size] = gen();
+        }
     }
 
+    // The evaluator key is not part of the position, callers add it through selectEvaluator().
     uint64_t computeHash(const GameState& state) {
         uint64_t h = 0;
         for (const auto& pair : state.pawnPositions) {
@@ -139,6 +230,11 @@ namespace Zobrist {
         h ^= turnKeys[state.playerTurnIndex];
         return h;
     }
+
+    // Opening book key: the position hash plus the board size, without any evaluator key.
+    uint64_t bookKey(const GameState& state) {
+        return computeHash(state) ^ boardSizeKeys[state.boardSize];
+    }
 }
 
 // --- FORWARD DECLARATIONS ---
@@ -148,6 +244,14 @@ int getShortestPathLength(const PawnPos& startPos, const std::function<bool(int,
 
 // --- CORE GAME LOGIC ---
 
+std::function<bool(int, int, int)> goalConditionFor(const std::string& playerId) {
+    if (playerId == "p1") return [](int r, int c, int boardSize) { return r == 0; };
+    if (playerId == "p2") return [](int r, int c, int boardSize) { return c == 0; };
+    if (playerId == "p3") return [](int r, int c, int boardSize) { return r == boardSize - 1; };
+    if (playerId == "p4") return [](int r, int c, int boardSize) { return c == boardSize - 1; };
+    return nullptr;
+}
+
 bool isWallBetween(const std::vector<Wall>& placedWalls, int r1, int c1, int r2, int c2) {
     if (c1 == c2) { // Vertical movement
         int wallRow = std::min(r1, r2);
@@ -273,6 +377,11 @@ GameState applyPawnMove(GameState gameState, const PawnPos& moveData, const std:
     gameState.zobristHash ^= Zobrist::pawnKeys[playerIndex][oldPos.row][oldPos.col];
     gameState.zobristHash ^= Zobrist::pawnKeys[playerIndex][moveData.row][moveData.col];
 
+    if (gameState.useNnue) {
+        Nnue::subFeature(gameState.accumulator, Nnue::pawnFeature(playerIndex, oldPos.row, oldPos.col));
+        Nnue::addFeature(gameState.accumulator, Nnue::pawnFeature(playerIndex, moveData.row, moveData.col));
+    }
+
     gameState.pawnPositions[currentPlayerId] = moveData;
     
     const Player* currentPlayer = &players[playerIndex];
@@ -293,12 +402,46 @@ GameState applyWallPlacement(GameState gameState, const Wall& wallData) {
         gameState.zobristHash ^= Zobrist::v_wallKeys[wallData.row][wallData.col];
     }
 
+    if (gameState.useNnue) {
+        int wallsLeft = gameState.wallsLeft[gameState.playerTurn];
+        Nnue::addFeature(gameState.accumulator, Nnue::wallFeature(wallData.orientation == "horizontal", wallData.row, wallData.col));
+        Nnue::subFeature(gameState.accumulator, Nnue::wallsLeftFeature(gameState.playerTurnIndex, wallsLeft));
+        Nnue::addFeature(gameState.accumulator, Nnue::wallsLeftFeature(gameState.playerTurnIndex, wallsLeft - 1));
+    }
+
     gameState.placedWalls.push_back(wallData);
     gameState.wallsLeft[gameState.playerTurn]--;
     gameState = switchTurn(gameState);
     return gameState;
 }
 
+// Switches the state to the requested evaluator. The network is only used when weights are loaded;
+// its accumulator is built here once and then updated incrementally by applyMove.
+void selectEvaluator(GameState& state, EvaluatorType evaluator) {
+    bool useNnue = evaluator == NNUE_EVAL && Nnue::networkLoaded;
+    if (useNnue == state.useNnue) return;
+    state.useNnue = useNnue;
+    state.zobristHash ^= Zobrist::nnueKey;
+    if (!useNnue) return;
+
+    std::vector<int> features;
+    for (int slot = 0; slot < static_cast<int>(state.activePlayerIds.size()); ++slot) {
+        const std::string& id = state.activePlayerIds[slot];
+        auto pos = state.pawnPositions.find(id);
+        if (pos != state.pawnPositions.end() && pos->second.row >= 0) {
+            features.push_back(Nnue::pawnFeature(slot, pos->second.row, pos->second.col));
+        }
+        auto walls = state.wallsLeft.find(id);
+        if (walls != state.wallsLeft.end()) {
+            features.push_back(Nnue::wallsLeftFeature(slot, walls->second));
+        }
+    }
+    for (const auto& wall : state.placedWalls) {
+        features.push_back(Nnue::wallFeature(wall.orientation == "horizontal", wall.row, wall.col));
+    }
+    Nnue::refresh(state.accumulator, features);
+}
+
 GameState applyMove(GameState gameState, const Move& move, const std::vector<Player>& players) {
     if (move.type == "cell") {
         return applyPawnMove(gameState, move.pos, players);
@@ -308,6 +451,137 @@ GameState applyMove(GameState gameState, const Move& move, const std::vector<Pla
     return gameState;
 }
 
+bool isMoveLegal(const GameState& state, const Move& move, const std::vector<Player>& players) {
+    if (state.status != "active") return false;
+    if (move.type == "cell") {
+        std::vector<PawnPos> pawnMoves = calculateLegalPawnMoves(state.pawnPositions, state.placedWalls, players, state.activePlayerIds, state.playerTurnIndex, state.boardSize);
+        return std::find(pawnMoves.begin(), pawnMoves.end(), move.pos) != pawnMoves.end();
+    }
+    if (move.type == "wall") {
+        return (move.wall.orientation == "horizontal" || move.wall.orientation == "vertical") && isWallPlacementLegal(move.wall, state, players);
+    }
+    return false;
+}
+
+// Mirrors GameLogic.applyPlayerLoss: the player leaves the turn order and the board. The player is
+// also dropped from `players`, which the rules index by turn slot.
+void applyPlayerLoss(GameState& state, std::vector<Player>& players, const std::string& losingPlayerId) {
+    if (state.status != "active") return;
+    auto it = std::find(state.activePlayerIds.begin(), state.activePlayerIds.end(), losingPlayerId);
+    if (it == state.activePlayerIds.end()) return;
+
+    int playerIndex = static_cast<int>(std::distance(state.activePlayerIds.begin(), it));
+    state.activePlayerIds.erase(it);
+    state.pawnPositions.erase(losingPlayerId);
+    players.erase(std::remove_if(players.begin(), players.end(), [&](const Player& p) { return p.id == losingPlayerId; }), players.end());
+
+    if (state.activePlayerIds.size() == 1) {
+        state.status = "ended";
+        state.winner = state.activePlayerIds[0];
+        state.playerTurn = "";
+    } else if (state.playerTurn == losingPlayerId) {
+        state.playerTurnIndex = playerIndex % state.activePlayerIds.size();
+        state.playerTurn = state.activePlayerIds[state.playerTurnIndex];
+    } else {
+        state.playerTurnIndex = static_cast<int>(std::distance(state.activePlayerIds.begin(),
+            std::find(state.activePlayerIds.begin(), state.activePlayerIds.end(), state.playerTurn)));
+    }
+    state.zobristHash = Zobrist::computeHash(state);
+}
+
+// Mirrors Game.js: walls per player by board size and player count.
+int wallsPerPlayer(int boardSize, int numPlayers) {
+    switch (boardSize) {
+        case 5: return numPlayers == 2 ? 4 : 2;
+        case 7: return numPlayers == 2 ? 8 : 4;
+        case 11: return numPlayers == 2 ? 12 : 6;
+        default: return numPlayers == 2 ? 10 : 5;
+    }
+}
+
+// Mirrors the startPos functions in gameConfig.js.
+PawnPos startPositionFor(const std::string& playerId, int boardSize) {
+    int middle = boardSize / 2;
+    if (playerId == "p1") return {boardSize - 1, middle};
+    if (playerId == "p2") return {middle, boardSize - 1};
+    if (playerId == "p3") return {0, middle};
+    return {middle, 0};
+}
+
+GameState createInitialState(int boardSize, const std::vector<std::string>& ids, int walls, std::vector<Player>& players) {
+    GameState state;
+    state.boardSize = boardSize;
+    state.activePlayerIds = ids;
+    state.playerTurnIndex = 0;
+    state.playerTurn = ids[0];
+    players.clear();
+    for (const auto& id : ids) {
+        state.pawnPositions[id] = startPositionFor(id, boardSize);
+        state.wallsLeft[id] = walls;
+        players.push_back({id, goalConditionFor(id)});
+    }
+    state.zobristHash = Zobrist::computeHash(state);
+    return state;
+}
+
+// Start position as set up by Game.js: P1 vs P3 for two players, P1-P4 for four.
+GameState createInitialState(int boardSize, int numPlayers, std::vector<Player>& players) {
+    std::vector<std::string> ids = numPlayers == 2 ? std::vector<std::string>{"p1", "p3"} : std::vector<std::string>{"p1", "p2", "p3", "p4"};
+    return createInitialState(boardSize, ids, wallsPerPlayer(boardSize, numPlayers), players);
+}
+
+// Returns the opening book move for the position, or a move with an empty type when there is none.
+Move probeBook(const GameState& state, const std::vector<Player>& players) {
+    if (!Book::loaded()) return {};
+    const Book::Entry* entry = Book::probe(Zobrist::bookKey(state));
+    if (!entry) return {};
+    Move move = decodeMove(entry->move);
+    // Guards against hash collisions with positions the book was not generated for.
+    return isMoveLegal(state, move, players) ? move : Move{};
+}
+
+// Authoritative rules for one server-side game. The board stays in native (or WASM) memory, so a
+// move request is validated and applied without converting or copying the whole game state.
+// Wrapped for JS by the Embind bindings below and by server/native/RulesAddon.cpp.
+class RulesGame {
+public:
+    RulesGame(int boardSize, int walls, const std::vector<std::string>& playerIds)
+        : state(createInitialState(boardSize, playerIds, walls, players)) {}
+
+    // Each returns false, leaving the game untouched, when the move is illegal.
+    bool playPawn(int row, int col) {
+        return play({"cell", {row, col}, {}});
+    }
+
+    bool placeWall(int row, int col, const std::string& orientation) {
+        return play({"wall", {}, {row, col, orientation}});
+    }
+
+    void removePlayer(const std::string& playerId) {
+        applyPlayerLoss(state, players, playerId);
+    }
+
+    std::vector<PawnPos> legalPawnMoves() const {
+        if (state.status != "active") return {};
+        return calculateLegalPawnMoves(state.pawnPositions, state.placedWalls, players, state.activePlayerIds, state.playerTurnIndex, state.boardSize);
+    }
+
+    std::string playerTurn() const { return state.playerTurn; }
+    int playerTurnIndex() const { return state.playerTurnIndex; }
+    std::string status() const { return state.status; }
+    std::string winner() const { return state.winner; }
+
+private:
+    bool play(const Move& move) {
+        if (!isMoveLegal(state, move, players)) return false;
+        state = applyMove(state, move, players);
+        return true;
+    }
+
+    std::vector<Player> players; // Declared first: the constructor fills it while building the state
+    GameState state;
+};
+
 // --- AI LOGIC ---//
 
 int getShortestPathLength(const PawnPos& startPos, const std::function<bool(int, int, int)>& goalCondition, const std::vector<Wall>& placedWalls, int boardSize) {
@@ -353,6 +627,12 @@ int evaluate(const GameState& state, const std::vector<Player>& players) {
         return (state.winner == state.playerTurn) ? INT_MAX : -INT_MAX;
     }
 
+    if (state.useNnue) {
+        // Keep network scores clear of the range reserved for wins and losses.
+        int score = Nnue::evaluate(state.accumulator, state.playerTurnIndex);
+        return std::max(-900000, std::min(900000, score));
+    }
+
     std::string myId = state.playerTurn;
     const Player* myPlayer = nullptr;
     for(const auto& p : players) {
@@ -530,14 +810,19 @@ int minimax(GameState state, int depth, bool maximizingPlayer, const std::vector
     }
 }
 
-int negamax(GameState state, int depth, int alpha, int beta, int color, const std::vector<Player>& players, int ply, 
+int negamax(GameState state, int depth, int alpha, int beta, const std::vector<Player>& players, int ply, 
             bool useAlphaBeta, bool useNullMovePruning, bool useTranspositionTable) {
     
     int alphaOrig = alpha;
+    Move hashMove;
+    nodesSearched++;
 
     // --- 1. Transposition Table Lookup ---
     if (useTranspositionTable) {
         auto it = transpositionTable.find(state.zobristHash);
+        if (it != transpositionTable.end()) {
+            hashMove = it->second.bestMove;
+        }
         if (it != transpositionTable.end() && it->second.depth >= depth) {
             TTEntry entry = it->second;
             int score = entry.score;
@@ -556,14 +841,16 @@ int negamax(GameState state, int depth, int alpha, int beta, int color, const st
         int base_score = evaluate(state, players);
         if (base_score > 900000) base_score -= ply;
         if (base_score < -900000) base_score += ply;
-        return color * base_score;
+        // evaluate() scores for state.playerTurn. A finished game keeps the winner as playerTurn,
+        // so the score is flipped to the point of view of the side that would move next.
+        return state.status == "ended" ? -base_score : base_score;
     }
 
     // --- 2. Null Move Pruning ---
     const int R = 3; 
     if (useNullMovePruning && depth >= R + 1 && state.wallsLeft.at(state.playerTurn) > 0) {
         GameState tempState = switchTurn(state);
-        int null_move_score = -negamax(tempState, depth - 1 - R, -beta, -beta + 1, -color, players, ply + 1, useAlphaBeta, useNullMovePruning, useTranspositionTable);
+        int null_move_score = -negamax(tempState, depth - 1 - R, -beta, -beta + 1, players, ply + 1, useAlphaBeta, useNullMovePruning, useTranspositionTable);
 
         if (useAlphaBeta && null_move_score >= beta) {
             return beta; 
@@ -573,10 +860,19 @@ int negamax(GameState state, int depth, int alpha, int beta, int color, const st
     // --- Search Logic ---
     std::vector<Move> moves = generateAndOrderMoves(state, players);
     if (moves.empty()) {
-        return color * evaluate(state, players);
+        return evaluate(state, players);
+    }
+
+    // Search the move stored by a previous (shallower) visit first.
+    if (!hashMove.type.empty()) {
+        auto it = std::find(moves.begin(), moves.end(), hashMove);
+        if (it != moves.end() && it != moves.begin()) {
+            std::rotate(moves.begin(), it, it + 1);
+        }
     }
 
     int maxVal = -INT_MAX;
+    Move bestMove = moves[0];
     for (const auto& move : moves) {
         GameState nextState = applyMove(state, move, players);
         
@@ -585,9 +881,12 @@ int negamax(GameState state, int depth, int alpha, int beta, int color, const st
         int next_beta = useAlphaBeta ? -alpha : INT_MAX;
 
         // Recursive call with flags
-        int val = -negamax(nextState, depth - 1, next_alpha, next_beta, -color, players, ply + 1, useAlphaBeta, useNullMovePruning, useTranspositionTable); 
+        int val = -negamax(nextState, depth - 1, next_alpha, next_beta, players, ply + 1, useAlphaBeta, useNullMovePruning, useTranspositionTable); 
         
-        maxVal = std::max(maxVal, val);
+        if (val > maxVal) {
+            maxVal = val;
+            bestMove = move;
+        }
         alpha = std::max(alpha, val);
         
         // --- Alpha-Beta Pruning Check ---
@@ -604,12 +903,359 @@ int negamax(GameState state, int depth, int alpha, int beta, int color, const st
         if (maxVal <= alphaOrig) new_entry.flag = UPPERBOUND;
         else if (maxVal >= beta) new_entry.flag = LOWERBOUND;
         else new_entry.flag = EXACT;
+        new_entry.bestMove = bestMove;
         transpositionTable[state.zobristHash] = new_entry;
     }
     
     return maxVal;
 }
 
+// Follows the best moves stored in the transposition table to recover the principal variation.
+std::vector<Move> extractPV(GameState state, const std::vector<Player>& players, int maxLength) {
+    std::vector<Move> pv;
+    std::set<uint64_t> seen;
+    while (static_cast<int>(pv.size()) < maxLength && state.status != "ended") {
+        auto it = transpositionTable.find(state.zobristHash);
+        if (it == transpositionTable.end() || it->second.bestMove.type.empty()) break;
+        if (!seen.insert(state.zobristHash).second) break; // Repetition, stop before looping forever
+        pv.push_back(it->second.bestMove);
+        state = applyMove(state, it->second.bestMove, players);
+    }
+    return pv;
+}
+
+// Iterative deepening search at the root. With multiPV > 1 the top-K root moves are found one
+// after another: each line searches the moves not yet picked, so its winner gets an exact score.
+// All lines and iterations share the transposition table, so later lines are mostly TT hits.
+// onInfo (if set) is called once per line per completed iteration.
+std::vector<RootLine> searchRoot(const GameState& state, const std::vector<Player>& players, int targetDepth, int multiPV,
+                                 const std::function<void(const SearchInfo&)>& onInfo) {
+    std::vector<RootLine> lines;
+    std::vector<Move> rootMoves = generateAndOrderMoves(state, players);
+    if (rootMoves.empty()) return lines;
+
+    const int numLines = std::max(1, std::min(multiPV, static_cast<int>(rootMoves.size())));
+    nodesSearched = 0;
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // --- ITERATIVE DEEPENING LOOP ---
+    for (int current_depth = 1; current_depth <= targetDepth; ++current_depth) {
+        std::vector<RootLine> linesThisIteration;
+        std::vector<Move> remaining = rootMoves; // Ordered from the previous iteration's results
+
+        for (int lineIndex = 0; lineIndex < numLines; ++lineIndex) {
+            int alpha = -INT_MAX;
+            auto bestIt = remaining.begin();
+
+            for (auto it = remaining.begin(); it != remaining.end(); ++it) {
+                GameState nextState = applyMove(state, *it, players);
+                int value = -negamax(nextState, current_depth - 1, -INT_MAX, -alpha, players, 1, true, true, true);
+                if (value > alpha) {
+                    alpha = value;
+                    bestIt = it;
+                }
+            }
+
+            RootLine line;
+            line.move = *bestIt;
+            line.score = alpha;
+            line.pv.push_back(*bestIt);
+            std::vector<Move> rest = extractPV(applyMove(state, *bestIt, players), players, current_depth - 1);
+            line.pv.insert(line.pv.end(), rest.begin(), rest.end());
+            remaining.erase(bestIt);
+
+            if (onInfo) {
+                auto now = std::chrono::high_resolution_clock::now();
+                long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(now - startTime).count();
+                SearchInfo info;
+                info.depth = current_depth;
+                info.multiPV = lineIndex + 1;
+                info.score = line.score;
+                info.nodes = nodesSearched;
+                info.nps = elapsedUs > 0 ? nodesSearched * 1000000 / elapsedUs : 0;
+                info.timeMs = elapsedUs / 1000;
+                info.pv = line.pv;
+                onInfo(info);
+            }
+            linesThisIteration.push_back(line);
+        }
+        lines = linesThisIteration;
+
+        // Re-order the root moves for the next, deeper search: this iteration's lines first, best first.
+        std::vector<Move> reordered;
+        for (const auto& line : lines) reordered.push_back(line.move);
+        for (const auto& move : rootMoves) {
+            if (std::find(reordered.begin(), reordered.end(), move) == reordered.end()) reordered.push_back(move);
+        }
+        rootMoves = reordered;
+    }
+    return lines;
+}
+
+// --- MCTS ENGINE ---
+// UCT over one tree shared by all threads (tree parallelism). Nodes live in a fixed arena and the
+// children of a node are allocated as one contiguous block, so the tree never moves while it is read.
+// Visits are counted on the way down and wins on the way back up: a path another thread is still
+// playing out looks like a loss until its result arrives (virtual loss), which spreads threads out.
+
+struct MctsNode {
+    PackedMove move;
+    int8_t moverSlot = 0;                // Turn index of the player who made `move`
+    std::atomic<uint8_t> expansion{0};   // 0 leaf, 1 being expanded, 2 children ready
+    uint16_t childCount = 0;
+    uint32_t firstChild = 0;
+    std::atomic<int> visits{0};
+    std::atomic<int> wins{0};
+};
+
+class NodePool {
+public:
+    explicit NodePool(uint32_t capacity) : nodes(new MctsNode[capacity]), capacity(capacity), next(0) {}
+
+    // Reserves `count` consecutive nodes. Returns UINT32_MAX once the arena is exhausted.
+    uint32_t allocate(uint32_t count) {
+        uint32_t start = next.fetch_add(count);
+        if (static_cast<uint64_t>(start) + count > capacity) return UINT32_MAX;
+        return start;
+    }
+
+    // Clears only the nodes handed out since the last reset, so a reused arena costs in
+    // proportion to the previous tree rather than to its capacity.
+    void reset() {
+        for (uint32_t i = 0, used = size(); i < used; ++i) {
+            MctsNode& node = nodes[i];
+            node.moverSlot = 0;
+            node.expansion.store(0, std::memory_order_relaxed);
+            node.childCount = 0;
+            node.firstChild = 0;
+            node.visits.store(0, std::memory_order_relaxed);
+            node.wins.store(0, std::memory_order_relaxed);
+        }
+        next.store(0);
+    }
+
+    bool full() const { return next.load() >= capacity; }
+    uint32_t size() const { return std::min(next.load(), capacity); }
+    MctsNode& operator[](uint32_t index) { return nodes[index]; }
+
+private:
+    std::unique_ptr<MctsNode[]> nodes;
+    uint32_t capacity;
+    std::atomic<uint32_t> next;
+};
+
+struct MctsResult {
+    Move bestMove;
+    long long playouts;
+    long long timeMs;
+    int threads;
+    uint32_t nodes;
+    double winRate;      // Of the chosen move, for the side to move at the root
+    double averageDepth; // Tree depth at which playouts started, averaged over all playouts
+};
+
+int availableThreads() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return 1;
+#else
+    unsigned int count = std::thread::hardware_concurrency();
+    return count > 0 ? static_cast<int>(count) : 1;
+#endif
+}
+
+// Path-biased random playout. Returns the turn slot of the winner; playouts that run too long are
+// given to the player closest to their goal.
+int runPlayout(GameState state, const std::vector<Player>& players, std::mt19937& rng) {
+    for (int ply = 0; ply < MCTS_MAX_PLAYOUT_PLIES && state.status != "ended"; ++ply) {
+        if (state.wallsLeft.at(state.playerTurn) > 0 && static_cast<int>(rng() % 100) < MCTS_WALL_PROBABILITY) {
+            Wall wall = {static_cast<int>(rng() % (state.boardSize - 1)), static_cast<int>(rng() % (state.boardSize - 1)),
+                         (rng() & 1) ? "horizontal" : "vertical"};
+            if (isWallPlacementLegal(wall, state, players)) {
+                state = applyWallPlacement(state, wall);
+                continue;
+            }
+        }
+
+        std::vector<PawnPos> pawnMoves = calculateLegalPawnMoves(state.pawnPositions, state.placedWalls, players, state.activePlayerIds, state.playerTurnIndex, state.boardSize);
+        if (pawnMoves.empty()) {
+            state = switchTurn(state);
+            continue;
+        }
+
+        PawnPos chosen = pawnMoves[rng() % pawnMoves.size()];
+        if (static_cast<int>(rng() % 100) < MCTS_GREEDY_PROBABILITY) {
+            const Player& mover = players[state.playerTurnIndex];
+            int bestPath = INT_MAX;
+            for (const auto& pos : pawnMoves) {
+                int path = getShortestPathLength(pos, mover.goalCondition, state.placedWalls, state.boardSize);
+                if (path != -1 && path < bestPath) {
+                    bestPath = path;
+                    chosen = pos;
+                }
+            }
+        }
+        state = applyPawnMove(state, chosen, players);
+    }
+
+    if (state.status == "ended") {
+        return static_cast<int>(std::distance(state.activePlayerIds.begin(),
+            std::find(state.activePlayerIds.begin(), state.activePlayerIds.end(), state.winner)));
+    }
+
+    int winnerSlot = state.playerTurnIndex;
+    int shortestPath = INT_MAX;
+    for (int slot = 0; slot < static_cast<int>(state.activePlayerIds.size()); ++slot) {
+        const PawnPos& pos = state.pawnPositions.at(state.activePlayerIds[slot]);
+        int path = getShortestPathLength(pos, players[slot].goalCondition, state.placedWalls, state.boardSize);
+        if (path != -1 && path < shortestPath) {
+            shortestPath = path;
+            winnerSlot = slot;
+        }
+    }
+    return winnerSlot;
+}
+
+// Creates the children of a leaf. Only the thread that wins the 0 -> 1 transition expands;
+// the others keep treating the node as a leaf until the children are published.
+void expandNode(NodePool& pool, uint32_t nodeIndex, const GameState& state, const std::vector<Player>& players) {
+    MctsNode& node = pool[nodeIndex];
+    uint8_t expected = 0;
+    if (pool.full() || !node.expansion.compare_exchange_strong(expected, 1)) return;
+
+    std::vector<Move> moves = generateAndOrderMoves(state, players);
+    uint32_t first = moves.empty() ? UINT32_MAX : pool.allocate(static_cast<uint32_t>(moves.size()));
+    if (first == UINT32_MAX) {
+        node.expansion.store(0);
+        return;
+    }
+
+    for (size_t i = 0; i < moves.size(); ++i) {
+        pool[first + i].move = packMove(moves[i]);
+        pool[first + i].moverSlot = static_cast<int8_t>(state.playerTurnIndex);
+    }
+    node.firstChild = first;
+    node.childCount = static_cast<uint16_t>(moves.size());
+    node.expansion.store(2, std::memory_order_release);
+}
+
+// UCT selection. Unvisited children are taken first, in move-ordering order.
+uint32_t selectChild(NodePool& pool, uint32_t nodeIndex) {
+    MctsNode& node = pool[nodeIndex];
+    double logParentVisits = std::log(static_cast<double>(std::max(1, node.visits.load())));
+    uint32_t best = node.firstChild;
+    double bestValue = -1.0;
+
+    for (uint32_t i = node.firstChild; i < node.firstChild + node.childCount; ++i) {
+        int visits = pool[i].visits.load(std::memory_order_relaxed);
+        if (visits == 0) return i;
+        double value = static_cast<double>(pool[i].wins.load(std::memory_order_relaxed)) / visits +
+                       MCTS_EXPLORATION * std::sqrt(logParentVisits / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+void mctsWorker(const GameState& rootState, const std::vector<Player>& players, NodePool& pool,
+                std::chrono::high_resolution_clock::time_point deadline, long long playoutLimit,
+                std::atomic<long long>& playouts, std::atomic<long long>& depthSum, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint32_t> path;
+    long long localDepthSum = 0;
+
+    while (std::chrono::high_resolution_clock::now() < deadline && (playoutLimit <= 0 || playouts.load() < playoutLimit)) {
+        GameState state = rootState;
+        uint32_t nodeIndex = 0;
+        path.clear();
+        path.push_back(nodeIndex);
+        pool[nodeIndex].visits.fetch_add(1);
+
+        // --- 1. Selection ---
+        while (state.status != "ended" && pool[nodeIndex].expansion.load(std::memory_order_acquire) == 2) {
+            nodeIndex = selectChild(pool, nodeIndex);
+            pool[nodeIndex].visits.fetch_add(1);
+            path.push_back(nodeIndex);
+            state = applyMove(state, unpackMove(pool[nodeIndex].move), players);
+        }
+
+        // --- 2. Expansion ---
+        if (state.status != "ended" && (nodeIndex == 0 || pool[nodeIndex].visits.load() >= MCTS_EXPANSION_VISITS)) {
+            expandNode(pool, nodeIndex, state, players);
+            if (pool[nodeIndex].expansion.load(std::memory_order_acquire) == 2) {
+                nodeIndex = selectChild(pool, nodeIndex);
+                pool[nodeIndex].visits.fetch_add(1);
+                path.push_back(nodeIndex);
+                state = applyMove(state, unpackMove(pool[nodeIndex].move), players);
+            }
+        }
+
+        // --- 3. Playout ---
+        int winnerSlot = runPlayout(state, players, rng);
+
+        // --- 4. Backpropagation ---
+        for (uint32_t index : path) {
+            if (pool[index].moverSlot == winnerSlot) pool[index].wins.fetch_add(1);
+        }
+        localDepthSum += static_cast<long long>(path.size()) - 1;
+        playouts.fetch_add(1);
+    }
+    depthSum.fetch_add(localDepthSum);
+}
+
+// Runs UCT for timeMs (and at most playoutLimit playouts when it is positive) on `threads` threads.
+MctsResult searchMcts(const GameState& state, const std::vector<Player>& players, int timeMs, int threads, long long playoutLimit) {
+    MctsResult result;
+    result.bestMove = {"resign", {}, {}};
+    result.threads = std::max(1, std::min(threads > 0 ? threads : availableThreads(), availableThreads()));
+
+    // Each calling thread allocates its arena once and resets it for every later search.
+    thread_local NodePool pool(MCTS_NODE_CAPACITY);
+    pool.reset();
+    pool.allocate(1); // Root
+    pool[0].moverSlot = -1;
+
+    std::atomic<long long> playouts(0);
+    std::atomic<long long> depthSum(0);
+    auto startTime = std::chrono::high_resolution_clock::now();
+    auto deadline = startTime + std::chrono::milliseconds(std::max(1, timeMs));
+    unsigned int baseSeed = static_cast<unsigned int>(startTime.time_since_epoch().count());
+
+    std::vector<std::thread> helpers;
+    for (int t = 1; t < result.threads; ++t) {
+        helpers.emplace_back(mctsWorker, std::cref(state), std::cref(players), std::ref(pool), deadline, playoutLimit, std::ref(playouts), std::ref(depthSum), baseSeed + t);
+    }
+    mctsWorker(state, players, pool, deadline, playoutLimit, playouts, depthSum, baseSeed);
+    for (auto& helper : helpers) helper.join();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+    result.playouts = playouts.load();
+    result.nodes = pool.size();
+    result.winRate = 0.0;
+    result.averageDepth = result.playouts > 0 ? static_cast<double>(depthSum.load()) / result.playouts : 0.0;
+
+    // The most visited root child is the most robust choice.
+    MctsNode& root = pool[0];
+    int bestVisits = -1;
+    if (root.expansion.load() == 2) {
+        for (uint32_t i = root.firstChild; i < root.firstChild + root.childCount; ++i) {
+            int visits = pool[i].visits.load();
+            if (visits > bestVisits) {
+                bestVisits = visits;
+                result.bestMove = unpackMove(pool[i].move);
+                result.winRate = visits > 0 ? static_cast<double>(pool[i].wins.load()) / visits : 0.0;
+            }
+        }
+    }
+    return result;
+}
+
+// --- JS BINDINGS ---
+// Everything below converts between JS values and the engine; native builds stop here.
+#ifdef __EMSCRIPTEN__
+
 GameState jsToCppState(const emscripten::val& jsState) {
     GameState state;
     state.boardSize = jsState["boardSize"].as<int>();
@@ -651,17 +1297,43 @@ std::vector<Player> jsToCppPlayers(const emscripten::val& jsPlayers) {
         std::string id = jsPlayers[i]["id"].as<std::string>();
         Player player;
         player.id = id;
-        
-        if (id == "p1") player.goalCondition = [](int r, int c, int boardSize) { return r == 0; };
-        else if (id == "p2") player.goalCondition = [](int r, int c, int boardSize) { return c == 0; };
-        else if (id == "p3") player.goalCondition = [](int r, int c, int boardSize) { return r == boardSize - 1; };
-        else if (id == "p4") player.goalCondition = [](int r, int c, int boardSize) { return c == boardSize - 1; };
-        
+        player.goalCondition = goalConditionFor(id);
         players.push_back(player);
     }
     return players;
 }
 
+// Reads the optional per-call settings object:
+// { depth, multiPV, evaluator: 'heuristic' | 'nnue', engine: 'negamax' | 'mcts', timeMs, threads, useBook }.
+SearchOptions jsToCppSearchOptions(const emscripten::val& jsOptions, int defaultDepth) {
+    SearchOptions options;
+    options.depth = defaultDepth;
+    if (jsOptions.isUndefined() || jsOptions.isNull()) return options;
+
+    if (jsOptions.hasOwnProperty("depth") && jsOptions["depth"].as<int>() > 0) {
+        options.depth = jsOptions["depth"].as<int>();
+    }
+    if (jsOptions.hasOwnProperty("multiPV") && jsOptions["multiPV"].as<int>() > 0) {
+        options.multiPV = jsOptions["multiPV"].as<int>();
+    }
+    if (jsOptions.hasOwnProperty("evaluator") && jsOptions["evaluator"].as<std::string>() == "nnue") {
+        options.evaluator = NNUE_EVAL;
+    }
+    if (jsOptions.hasOwnProperty("engine") && jsOptions["engine"].as<std::string>() == "mcts") {
+        options.engine = MCTS_ENGINE;
+    }
+    if (jsOptions.hasOwnProperty("timeMs") && jsOptions["timeMs"].as<int>() > 0) {
+        options.timeMs = jsOptions["timeMs"].as<int>();
+    }
+    if (jsOptions.hasOwnProperty("threads") && jsOptions["threads"].as<int>() > 0) {
+        options.threads = jsOptions["threads"].as<int>();
+    }
+    if (jsOptions.hasOwnProperty("useBook")) {
+        options.useBook = jsOptions["useBook"].as<bool>();
+    }
+    return options;
+}
+
 emscripten::val cppMoveToJs(const Move& move) {
     emscripten::val jsMove = emscripten::val::object();
     jsMove.set("type", move.type);
@@ -681,56 +1353,98 @@ emscripten::val cppMoveToJs(const Move& move) {
     return jsMove;
 }
 
-emscripten::val findBestMove(const emscripten::val& jsState, const emscripten::val& jsPlayers, int targetDepth) {
+emscripten::val cppMovesToJs(const std::vector<Move>& moves) {
+    emscripten::val jsMoves = emscripten::val::array();
+    for (const auto& move : moves) {
+        jsMoves.call<void>("push", cppMoveToJs(move));
+    }
+    return jsMoves;
+}
+
+emscripten::val cppSearchInfoToJs(const SearchInfo& info) {
+    emscripten::val jsInfo = emscripten::val::object();
+    jsInfo.set("depth", info.depth);
+    jsInfo.set("multiPV", info.multiPV);
+    jsInfo.set("score", info.score);
+    jsInfo.set("nodes", static_cast<double>(info.nodes));
+    jsInfo.set("nps", static_cast<double>(info.nps));
+    jsInfo.set("timeMs", static_cast<double>(info.timeMs));
+    jsInfo.set("pv", cppMovesToJs(info.pv));
+    return jsInfo;
+}
+
+emscripten::val findBestMove(const emscripten::val& jsState, const emscripten::val& jsPlayers, int targetDepth, const emscripten::val& jsOptions) {
     GameState state = jsToCppState(jsState);
     std::vector<Player> players = jsToCppPlayers(jsPlayers);
     
     // Use the passed-in depth, with a fallback to a reasonable default.
-    const int TARGET_DEPTH = (targetDepth > 0) ? targetDepth : 4; 
+    SearchOptions options = jsToCppSearchOptions(jsOptions, (targetDepth > 0) ? targetDepth : 4);
+
+    if (options.useBook) {
+        Move bookMove = probeBook(state, players);
+        if (!bookMove.type.empty()) return cppMoveToJs(bookMove);
+    }
+
+    if (options.engine == MCTS_ENGINE) {
+        return cppMoveToJs(searchMcts(state, players, options.timeMs, options.threads, 0).bestMove);
+    }
 
-    // Generate the initial list of moves just once.
-    std::vector<Move> movesToSearch = generateAndOrderMoves(state, players);
-    if (movesToSearch.empty()) {
+    selectEvaluator(state, options.evaluator);
+    std::vector<RootLine> lines = searchRoot(state, players, options.depth, 1, nullptr);
+    if (lines.empty()) {
         return cppMoveToJs({"resign", {}, {}});
     }
+    return cppMoveToJs(lines[0].move);
+}
 
-    Move bestMoveOverall = movesToSearch[0];
+// Analysis mode: searches to options.depth and reports every completed iteration through onInfo
+// (a JS function receiving {depth, multiPV, score, nodes, nps, timeMs, pv}). Returns the final
+// top-K lines as [{move, score, pv}], best first. Scores are from the side to move's point of view.
+emscripten::val analyzePosition(const emscripten::val& jsState, const emscripten::val& jsPlayers, const emscripten::val& jsOptions,
+                                const emscripten::val& onInfo) {
+    GameState state = jsToCppState(jsState);
+    std::vector<Player> players = jsToCppPlayers(jsPlayers);
 
-    // --- ITERATIVE DEEPENING LOOP ---
-    for (int current_depth = 1; current_depth <= TARGET_DEPTH; ++current_depth) {
-        Move bestMoveThisIteration = movesToSearch[0];
-        int bestValue = -INT_MAX;
+    SearchOptions options = jsToCppSearchOptions(jsOptions, 4);
+    selectEvaluator(state, options.evaluator);
 
-        // 'movesToSearch' vector is ordered from the previous iteration's results.
-        for (const auto& move : movesToSearch) {
-            GameState nextState = applyMove(state, move, players);
-            int value = -negamax(   nextState, 
-                                    current_depth - 1, 
-                                    -INT_MAX, 
-                                    INT_MAX, 
-                                    -1, 
-                                    players, 
-                                    1, 
-                                    true, 
-                                    true, 
-                                    true
-                                );
-            if (value > bestValue) {
-                bestValue = value;
-                bestMoveThisIteration = move;
-            }
-        }
-        bestMoveOverall = bestMoveThisIteration;
+    std::function<void(const SearchInfo&)> reportInfo = nullptr;
+    if (!onInfo.isUndefined() && !onInfo.isNull()) {
+        reportInfo = [&onInfo](const SearchInfo& info) { onInfo(cppSearchInfoToJs(info)); };
+    }
 
-        // Re-order the moves list for the next, deeper search.
-        // Find the best move from the completed iterationand move it to the front.
-        auto it = std::find(movesToSearch.begin(), movesToSearch.end(), bestMoveThisIteration);
-        if (it != movesToSearch.begin()) {
-            std::rotate(movesToSearch.begin(), it, it + 1);
-        }
+    std::vector<RootLine> lines = searchRoot(state, players, options.depth, options.multiPV, reportInfo);
+
+    emscripten::val jsLines = emscripten::val::array();
+    for (const auto& line : lines) {
+        emscripten::val jsLine = emscripten::val::object();
+        jsLine.set("move", cppMoveToJs(line.move));
+        jsLine.set("score", line.score);
+        jsLine.set("pv", cppMovesToJs(line.pv));
+        jsLines.call<void>("push", jsLine);
     }
-    
-    return cppMoveToJs(bestMoveOverall);
+    return jsLines;
+}
+
+// Loads evaluation network weights from a Uint8Array in the format described in Nnue.h.
+bool loadNetwork(const emscripten::val& jsBytes) {
+    std::vector<uint8_t> bytes = emscripten::convertJSArrayToNumberVector<uint8_t>(jsBytes);
+    transpositionTable.clear();
+    return Nnue::loadNetwork(bytes.data(), bytes.size());
+}
+
+bool isNetworkLoaded() {
+    return Nnue::networkLoaded;
+}
+
+// Loads an opening book (see Book.h) from a Uint8Array into module memory.
+bool loadBook(const emscripten::val& jsBytes) {
+    std::vector<uint8_t> bytes = emscripten::convertJSArrayToNumberVector<uint8_t>(jsBytes);
+    return Book::load(bytes.data(), bytes.size());
+}
+
+bool isBookLoaded() {
+    return Book::loaded();
 }
 
 emscripten::val runAblationBenchmark(const emscripten::val& jsState, const emscripten::val& jsPlayers, int depth) {
@@ -758,7 +1472,7 @@ emscripten::val runAblationBenchmark(const emscripten::val& jsState, const emscr
         transpositionTable.clear();
 
         auto startTime = std::chrono::high_resolution_clock::now();
-        int score = negamax(state, depth, -INT_MAX, INT_MAX, 1, players, 0, useAlphaBeta, useNullMovePruning, useTranspositionTable);
+        int score = negamax(state, depth, -INT_MAX, INT_MAX, players, 0, useAlphaBeta, useNullMovePruning, useTranspositionTable);
         auto endTime = std::chrono::high_resolution_clock::now();
         long long duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
 
@@ -772,9 +1486,106 @@ emscripten::val runAblationBenchmark(const emscripten::val& jsState, const emscr
     return results_array;
 }
 
+// Embind adapters for RulesGame: JS arrays in, JS objects out.
+RulesGame* createRulesGame(int boardSize, int walls, const emscripten::val& jsPlayerIds) {
+    return new RulesGame(boardSize, walls, emscripten::vecFromJSArray<std::string>(jsPlayerIds));
+}
+
+emscripten::val rulesGameLegalPawnMoves(const RulesGame& game) {
+    emscripten::val jsMoves = emscripten::val::array();
+    for (const auto& pos : game.legalPawnMoves()) {
+        emscripten::val jsPos = emscripten::val::object();
+        jsPos.set("row", pos.row);
+        jsPos.set("col", pos.col);
+        jsMoves.call<void>("push", jsPos);
+    }
+    return jsMoves;
+}
+
+// Searches the same position with each available evaluator to compare speed and chosen moves.
+emscripten::val runEvaluatorBenchmark(const emscripten::val& jsState, const emscripten::val& jsPlayers, int depth) {
+    GameState baseState = jsToCppState(jsState);
+    std::vector<Player> players = jsToCppPlayers(jsPlayers);
+
+    emscripten::val results_array = emscripten::val::array();
+
+    std::vector<std::pair<EvaluatorType, std::string>> evaluators = {{HEURISTIC_EVAL, "Heuristic"}};
+    if (Nnue::networkLoaded) evaluators.push_back({NNUE_EVAL, "NNUE"});
+
+    for (const auto& evaluator : evaluators) {
+        GameState state = baseState;
+        selectEvaluator(state, evaluator.first);
+        transpositionTable.clear();
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::vector<RootLine> lines = searchRoot(state, players, depth, 1, nullptr);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        long long duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+        emscripten::val result_obj = emscripten::val::object();
+        result_obj.set("name", evaluator.second);
+        result_obj.set("timeMs", duration);
+        result_obj.set("nodes", static_cast<double>(nodesSearched));
+        result_obj.set("nps", duration > 0 ? static_cast<double>(nodesSearched * 1000 / duration) : 0.0);
+        result_obj.set("score", lines.empty() ? 0 : lines[0].score);
+        result_obj.set("move", lines.empty() ? cppMoveToJs({"resign", {}, {}}) : cppMoveToJs(lines[0].move));
+        results_array.call<void>("push", result_obj);
+    }
+
+    return results_array;
+}
+
+// Runs MCTS for timeMs with 1, 2, 4, ... threads up to maxThreads to measure playout throughput and scaling.
+emscripten::val runMctsBenchmark(const emscripten::val& jsState, const emscripten::val& jsPlayers, int timeMs, int maxThreads) {
+    GameState state = jsToCppState(jsState);
+    std::vector<Player> players = jsToCppPlayers(jsPlayers);
+
+    emscripten::val results_array = emscripten::val::array();
+    int threadLimit = std::min(std::max(1, maxThreads), availableThreads());
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < threadLimit; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(threadLimit);
+
+    for (int threads : threadCounts) {
+        MctsResult result = searchMcts(state, players, timeMs, threads, 0);
+
+        emscripten::val result_obj = emscripten::val::object();
+        result_obj.set("threads", result.threads);
+        result_obj.set("timeMs", static_cast<double>(result.timeMs));
+        result_obj.set("playouts", static_cast<double>(result.playouts));
+        result_obj.set("playoutsPerSecond", result.timeMs > 0 ? static_cast<double>(result.playouts * 1000 / result.timeMs) : 0.0);
+        result_obj.set("nodes", result.nodes);
+        result_obj.set("winRate", result.winRate);
+        result_obj.set("move", cppMoveToJs(result.bestMove));
+        results_array.call<void>("push", result_obj);
+    }
+
+    return results_array;
+}
+
 EMSCRIPTEN_BINDINGS(quoridor_ai_module) {
     // Call Zobrist initialization once when the module loads
     Zobrist::initialize();
     emscripten::function("findBestMove", &findBestMove, emscripten::allow_raw_pointers());
+    emscripten::function("analyzePosition", &analyzePosition, emscripten::allow_raw_pointers());
+    emscripten::function("loadNetwork", &loadNetwork, emscripten::allow_raw_pointers());
+    emscripten::function("isNetworkLoaded", &isNetworkLoaded);
+    emscripten::function("loadBook", &loadBook, emscripten::allow_raw_pointers());
+    emscripten::function("isBookLoaded", &isBookLoaded);
     emscripten::function("runAblationBenchmark", &runAblationBenchmark, emscripten::allow_raw_pointers());
-}
\ No newline at end of file
+    emscripten::function("runEvaluatorBenchmark", &runEvaluatorBenchmark, emscripten::allow_raw_pointers());
+    emscripten::function("runMctsBenchmark", &runMctsBenchmark, emscripten::allow_raw_pointers());
+
+    emscripten::class_<RulesGame>("RulesGame")
+        .constructor(&createRulesGame, emscripten::allow_raw_pointers())
+        .function("playPawn", &RulesGame::playPawn)
+        .function("placeWall", &RulesGame::placeWall)
+        .function("removePlayer", &RulesGame::removePlayer)
+        .function("legalPawnMoves", &rulesGameLegalPawnMoves)
+        .function("playerTurn", &RulesGame::playerTurn)
+        .function("playerTurnIndex", &RulesGame::playerTurnIndex)
+        .function("status", &RulesGame::status)
+        .function("winner", &RulesGame::winner);
+}
+
+#endif // __EMSCRIPTEN__
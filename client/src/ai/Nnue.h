@@ -0,0 +1,255 @@
+// Quantized, incrementally updated evaluation network (NNUE-style).
+//
+// Topology: FEATURE_COUNT sparse binary inputs -> HIDDEN_SIZE int16 accumulator -> clipped ReLU
+// -> one int8 output head per side-to-move slot. Only the first layer is kept incrementally in
+// GameState; the output layer is a single dot product per evaluation.
+//
+// Inputs (absolute board coordinates on the 11x11 grid, so one network covers every board size):
+//   - pawn cells:   player slot (0-3) x 121 cells
+//   - wall slots:   horizontal 10x10, vertical 10x10
+//   - walls left:   player slot (0-3) x 11 counts (0-10)
+//
+// Weights file (little-endian):
+//   char    magic[4]        "OBNN"
+//   uint32  version         1
+//   uint32  featureCount    must equal FEATURE_COUNT
+//   uint32  hiddenSize      must equal HIDDEN_SIZE
+//   int32   outputScale     final score = (dot + outputBias) * outputScale / (QA * QB)
+//   int16   featureBias[HIDDEN_SIZE]
+//   int16   featureWeights[FEATURE_COUNT][HIDDEN_SIZE]
+//   int8    outputWeights[MAX_PLAYERS][HIDDEN_SIZE]
+//   int32   outputBias[MAX_PLAYERS]
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Nnue {
+    const int BOARD_CELLS = 11;
+    const int WALL_CELLS = BOARD_CELLS - 1;
+    const int MAX_PLAYERS = 4;
+    const int MAX_WALLS_LEFT = 10;
+
+    const int PAWN_FEATURES = MAX_PLAYERS * BOARD_CELLS * BOARD_CELLS;
+    const int WALL_FEATURES = 2 * WALL_CELLS * WALL_CELLS;
+    const int WALLS_LEFT_FEATURES = MAX_PLAYERS * (MAX_WALLS_LEFT + 1);
+    const int FEATURE_COUNT = PAWN_FEATURES + WALL_FEATURES + WALLS_LEFT_FEATURES;
+
+    const int HIDDEN_SIZE = 64;
+    const int QA = 127; // Clipped ReLU ceiling for the accumulator
+    const int QB = 64;  // Fixed-point scale of the output weights
+
+    const uint32_t FILE_VERSION = 1;
+
+    struct alignas(32) Accumulator {
+        int16_t values[HIDDEN_SIZE];
+    };
+
+    struct Network {
+        alignas(32) int16_t featureBias[HIDDEN_SIZE];
+        std::vector<int16_t> featureWeights; // FEATURE_COUNT * HIDDEN_SIZE, row per feature
+        alignas(32) int16_t outputWeights[MAX_PLAYERS][HIDDEN_SIZE]; // Widened from int8 on load for 16-bit madd
+        int32_t outputBias[MAX_PLAYERS];
+        int32_t outputScale;
+    };
+
+    inline Network network;
+    inline bool networkLoaded = false;
+
+    // --- FEATURE INDICES ---
+    inline int pawnFeature(int playerSlot, int row, int col) {
+        return (playerSlot * BOARD_CELLS + row) * BOARD_CELLS + col;
+    }
+
+    inline int wallFeature(bool horizontal, int row, int col) {
+        return PAWN_FEATURES + ((horizontal ? 0 : 1) * WALL_CELLS + row) * WALL_CELLS + col;
+    }
+
+    inline int wallsLeftFeature(int playerSlot, int wallsLeft) {
+        if (wallsLeft > MAX_WALLS_LEFT) wallsLeft = MAX_WALLS_LEFT;
+        if (wallsLeft < 0) wallsLeft = 0;
+        return PAWN_FEATURES + WALL_FEATURES + playerSlot * (MAX_WALLS_LEFT + 1) + wallsLeft;
+    }
+
+    // --- SIMD KERNELS ---
+    inline void addWeights(Accumulator& acc, const int16_t* weights) {
+#if defined(__wasm_simd128__)
+        for (int i = 0; i < HIDDEN_SIZE; i += 8) {
+            v128_t a = wasm_v128_load(acc.values + i);
+            wasm_v128_store(acc.values + i, wasm_i16x8_add(a, wasm_v128_load(weights + i)));
+        }
+#elif defined(__AVX2__)
+        for (int i = 0; i < HIDDEN_SIZE; i += 16) {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc.values + i));
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(acc.values + i), _mm256_add_epi16(a, w));
+        }
+#elif defined(__SSE2__)
+        for (int i = 0; i < HIDDEN_SIZE; i += 8) {
+            __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(acc.values + i));
+            __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+            _mm_store_si128(reinterpret_cast<__m128i*>(acc.values + i), _mm_add_epi16(a, w));
+        }
+#else
+        for (int i = 0; i < HIDDEN_SIZE; ++i) acc.values[i] += weights[i];
+#endif
+    }
+
+    inline void subWeights(Accumulator& acc, const int16_t* weights) {
+#if defined(__wasm_simd128__)
+        for (int i = 0; i < HIDDEN_SIZE; i += 8) {
+            v128_t a = wasm_v128_load(acc.values + i);
+            wasm_v128_store(acc.values + i, wasm_i16x8_sub(a, wasm_v128_load(weights + i)));
+        }
+#elif defined(__AVX2__)
+        for (int i = 0; i < HIDDEN_SIZE; i += 16) {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc.values + i));
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(acc.values + i), _mm256_sub_epi16(a, w));
+        }
+#elif defined(__SSE2__)
+        for (int i = 0; i < HIDDEN_SIZE; i += 8) {
+            __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(acc.values + i));
+            __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+            _mm_store_si128(reinterpret_cast<__m128i*>(acc.values + i), _mm_sub_epi16(a, w));
+        }
+#else
+        for (int i = 0; i < HIDDEN_SIZE; ++i) acc.values[i] -= weights[i];
+#endif
+    }
+
+    // Sum of clamp(acc, 0, QA) * weights, in 32-bit lanes.
+    inline int32_t clippedDot(const Accumulator& acc, const int16_t* weights) {
+#if defined(__wasm_simd128__)
+        v128_t zero = wasm_i16x8_splat(0);
+        v128_t ceiling = wasm_i16x8_splat(QA);
+        v128_t sum = wasm_i32x4_splat(0);
+        for (int i = 0; i < HIDDEN_SIZE; i += 8) {
+            v128_t a = wasm_i16x8_max(wasm_i16x8_min(wasm_v128_load(acc.values + i), ceiling), zero);
+            sum = wasm_i32x4_add(sum, wasm_i32x4_dot_i16x8(a, wasm_v128_load(weights + i)));
+        }
+        return wasm_i32x4_extract_lane(sum, 0) + wasm_i32x4_extract_lane(sum, 1) +
+               wasm_i32x4_extract_lane(sum, 2) + wasm_i32x4_extract_lane(sum, 3);
+#elif defined(__AVX2__)
+        __m256i zero = _mm256_setzero_si256();
+        __m256i ceiling = _mm256_set1_epi16(QA);
+        __m256i sum = _mm256_setzero_si256();
+        for (int i = 0; i < HIDDEN_SIZE; i += 16) {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc.values + i));
+            a = _mm256_max_epi16(_mm256_min_epi16(a, ceiling), zero);
+            __m256i w = _mm256_load_si256(reinterpret_cast<const __m256i*>(weights + i));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, w));
+        }
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(half);
+#elif defined(__SSE2__)
+        __m128i zero = _mm_setzero_si128();
+        __m128i ceiling = _mm_set1_epi16(QA);
+        __m128i sum = _mm_setzero_si128();
+        for (int i = 0; i < HIDDEN_SIZE; i += 8) {
+            __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(acc.values + i));
+            a = _mm_max_epi16(_mm_min_epi16(a, ceiling), zero);
+            __m128i w = _mm_load_si128(reinterpret_cast<const __m128i*>(weights + i));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(a, w));
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+#else
+        int32_t sum = 0;
+        for (int i = 0; i < HIDDEN_SIZE; ++i) {
+            int32_t a = acc.values[i] < 0 ? 0 : (acc.values[i] > QA ? QA : acc.values[i]);
+            sum += a * weights[i];
+        }
+        return sum;
+#endif
+    }
+
+    // --- ACCUMULATOR UPDATES ---
+    inline void addFeature(Accumulator& acc, int feature) {
+        addWeights(acc, network.featureWeights.data() + static_cast<size_t>(feature) * HIDDEN_SIZE);
+    }
+
+    inline void subFeature(Accumulator& acc, int feature) {
+        subWeights(acc, network.featureWeights.data() + static_cast<size_t>(feature) * HIDDEN_SIZE);
+    }
+
+    // Rebuilds the accumulator from scratch; used once at the search root.
+    inline void refresh(Accumulator& acc, const std::vector<int>& activeFeatures) {
+        std::memcpy(acc.values, network.featureBias, sizeof(acc.values));
+        for (int feature : activeFeatures) addFeature(acc, feature);
+    }
+
+    // Score from the point of view of the player in the given turn slot.
+    inline int evaluate(const Accumulator& acc, int turnSlot) {
+        int64_t raw = static_cast<int64_t>(clippedDot(acc, network.outputWeights[turnSlot])) + network.outputBias[turnSlot];
+        return static_cast<int>(raw * network.outputScale / (QA * QB));
+    }
+
+    // --- LOADING ---
+    template <typename T>
+    inline bool readValue(const uint8_t*& cursor, const uint8_t* end, T& out) {
+        if (static_cast<size_t>(end - cursor) < sizeof(T)) return false;
+        std::memcpy(&out, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    inline bool loadNetwork(const uint8_t* data, size_t size) {
+        const uint8_t* cursor = data;
+        const uint8_t* end = data + size;
+        networkLoaded = false;
+
+        char magic[4];
+        uint32_t version, featureCount, hiddenSize;
+        if (!readValue(cursor, end, magic) || std::memcmp(magic, "OBNN", 4) != 0) return false;
+        if (!readValue(cursor, end, version) || version != FILE_VERSION) return false;
+        if (!readValue(cursor, end, featureCount) || featureCount != static_cast<uint32_t>(FEATURE_COUNT)) return false;
+        if (!readValue(cursor, end, hiddenSize) || hiddenSize != static_cast<uint32_t>(HIDDEN_SIZE)) return false;
+        if (!readValue(cursor, end, network.outputScale)) return false;
+
+        for (int i = 0; i < HIDDEN_SIZE; ++i) {
+            if (!readValue(cursor, end, network.featureBias[i])) return false;
+        }
+
+        network.featureWeights.resize(static_cast<size_t>(FEATURE_COUNT) * HIDDEN_SIZE);
+        for (auto& weight : network.featureWeights) {
+            if (!readValue(cursor, end, weight)) return false;
+        }
+
+        for (int p = 0; p < MAX_PLAYERS; ++p) {
+            for (int i = 0; i < HIDDEN_SIZE; ++i) {
+                int8_t weight;
+                if (!readValue(cursor, end, weight)) return false;
+                network.outputWeights[p][i] = weight;
+            }
+        }
+        for (int p = 0; p < MAX_PLAYERS; ++p) {
+            if (!readValue(cursor, end, network.outputBias[p])) return false;
+        }
+
+        networkLoaded = cursor == end;
+        return networkLoaded;
+    }
+
+    inline bool loadNetworkFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return loadNetwork(bytes.data(), bytes.size());
+    }
+}
@@ -1,12 +1,19 @@
 // src/controllers/AIController.js
 
 export default class AIController {
-    constructor(scene, orchestrator, difficulty) {
+    constructor(scene, orchestrator, difficulty, searchOptions = {}) {
         this.orchestrator = orchestrator;
         this.difficulty = difficulty || 4; // Default to medium
+        // engine: 'negamax' or 'mcts' (timeMs is the MCTS budget), evaluator: 'heuristic' or 'nnue',
+        // useBook: play from the opening book when the position is in it
+        this.searchOptions = { engine: 'negamax', evaluator: 'heuristic', timeMs: 1000, useBook: true, ...searchOptions };
         this.worker = new Worker(new URL('../workers/ai.worker.js', import.meta.url), { type: 'module' });
         
-        this.resolveMovePromise = null;
+        this.analysisWorker = null; // { worker, ready }, created on the first analyze() call
+
+        this.nextRequestId = 1;
+        this.pendingMove = null;     // { id, resolve }
+        this.pendingAnalysis = null; // { id, resolve, reject, onInfo }
         
         this.readyPromise = new Promise(resolve => {
             this.makeWorkerReady = resolve;
@@ -14,12 +21,13 @@ export default class AIController {
 
         // Listen for messages coming back from the worker
         this.worker.onmessage = (event) => {
-            const { type, move } = event.data;
+            const { type, requestId, move } = event.data;
 
+            // Replies to superseded requests carry an old id and are ignored.
             if (type === 'move-calculated') {
-                if (this.resolveMovePromise) {
-                    this.resolveMovePromise(move);
-                    this.resolveMovePromise = null;
+                if (this.pendingMove && this.pendingMove.id === requestId) {
+                    this.pendingMove.resolve(move);
+                    this.pendingMove = null;
                 }
             } else if (type === 'worker-ready') {
                 console.log("AI Worker is ready.");
@@ -34,23 +42,106 @@ export default class AIController {
         await this.readyPromise;
 
         return new Promise((resolve) => {
-            this.resolveMovePromise = resolve;
+            const requestId = this.nextRequestId++;
+            this.pendingMove = { id: requestId, resolve };
 
             const gameState = this.orchestrator.getGameState();
             const serializablePlayers = this.orchestrator.players.map(p => ({ id: p.id }));
             
             this.worker.postMessage({
                 type: 'calculate-move',
+                requestId,
                 gameState,
                 players: serializablePlayers,
-                difficulty: this.difficulty
+                difficulty: this.difficulty,
+                searchOptions: this.searchOptions
             });
         });
     }
 
+    /**
+     * Analyzes a position without playing a move. onInfo receives one
+     * { depth, multiPV, score, nodes, nps, timeMs, pv } object per PV line
+     * as each iteration completes; the promise resolves with the final top-K lines.
+     * Analysis runs on its own worker, so it never delays getMove. Starting a new analysis
+     * stops the search it supersedes and rejects that search's promise.
+     */
+    analyze(gameState, { depth = this.difficulty, multiPV = 1, evaluator = this.searchOptions.evaluator } = {}, onInfo = null) {
+        if (this.pendingAnalysis) {
+            // The worker is blocked inside the old search until it finishes, so replace the worker.
+            this.pendingAnalysis.reject(new Error('Analysis superseded by a newer request'));
+            this.pendingAnalysis = null;
+            this.analysisWorker.worker.terminate();
+            this.analysisWorker = null;
+        }
+        if (!this.analysisWorker) this.analysisWorker = this._createAnalysisWorker();
+
+        const requestId = this.nextRequestId++;
+        const analysisWorker = this.analysisWorker;
+        const promise = new Promise((resolve, reject) => {
+            this.pendingAnalysis = { id: requestId, resolve, reject, onInfo };
+        });
+
+        analysisWorker.ready.then(() => {
+            if (!this.pendingAnalysis || this.pendingAnalysis.id !== requestId) return;
+            analysisWorker.worker.postMessage({
+                type: 'analyze',
+                requestId,
+                gameState,
+                players: this.orchestrator.players.map(p => ({ id: p.id })),
+                depth,
+                multiPV,
+                evaluator
+            });
+        });
+        return promise;
+    }
+
+    _createAnalysisWorker() {
+        const worker = new Worker(new URL('../workers/ai.worker.js', import.meta.url), { type: 'module' });
+        let makeReady;
+        const ready = new Promise(resolve => { makeReady = resolve; });
+
+        worker.onmessage = (event) => {
+            const { type, requestId, info, lines, message } = event.data;
+            const analysis = this.pendingAnalysis && this.pendingAnalysis.id === requestId ? this.pendingAnalysis : null;
+
+            if (type === 'search-info') {
+                if (analysis && analysis.onInfo) analysis.onInfo(info);
+            } else if (type === 'analysis-complete') {
+                if (analysis) {
+                    analysis.resolve(lines);
+                    this.pendingAnalysis = null;
+                }
+            } else if (type === 'analysis-error') {
+                if (analysis) {
+                    analysis.reject(new Error(message));
+                    this.pendingAnalysis = null;
+                }
+            } else if (type === 'worker-ready') {
+                makeReady();
+            } else if (type === 'worker-error') {
+                console.error("AI analysis worker failed to initialize.");
+                if (this.pendingAnalysis) this.pendingAnalysis.reject(new Error('AI analysis worker failed to initialize'));
+                this.pendingAnalysis = null;
+                worker.terminate();
+                if (this.analysisWorker && this.analysisWorker.worker === worker) this.analysisWorker = null;
+            }
+        };
+        return { worker, ready };
+    }
+
     destroy() {
         if (this.worker) {
             this.worker.terminate();
         }
+        if (this.analysisWorker) {
+            this.analysisWorker.worker.terminate();
+            this.analysisWorker = null;
+        }
+        if (this.pendingAnalysis) {
+            this.pendingAnalysis.reject(new Error('AI controller destroyed'));
+            this.pendingAnalysis = null;
+        }
     }
 }
\ No newline at end of file
@@ -3,9 +3,50 @@ import createQuoridorAIModule from '../../../public/ai/ai.js';
 
 let aiModule = null;
 
+// Network weights for the 'nnue' evaluator. Without them the engine falls back to the heuristic evaluator.
+const NNUE_WEIGHTS_URL = '/ai/nnue.bin';
+// Opening book generated by benchmark/bookgen.cpp. Without it every move is searched.
+const OPENING_BOOK_URL = '/ai/book.bin';
+
+// ai.js is a build artifact; one built before a binding was added to NegaMax.cpp lacks it.
+function hasBinding(module, name) {
+    if (typeof module[name] === 'function') return true;
+    console.warn(`AI Worker: ai.js has no ${name} binding; rebuild it with \`npm run build:wasm\`.`);
+    return false;
+}
+
+async function loadNetworkWeights(module) {
+    if (!hasBinding(module, 'loadNetwork')) return;
+    try {
+        const response = await fetch(NNUE_WEIGHTS_URL);
+        if (!response.ok) return;
+        const bytes = new Uint8Array(await response.arrayBuffer());
+        if (!module.loadNetwork(bytes)) {
+            console.warn("AI Worker: NNUE weights file is invalid, using the heuristic evaluator.");
+        }
+    } catch (err) {
+        console.warn("AI Worker: NNUE weights unavailable, using the heuristic evaluator.");
+    }
+}
+
+async function loadOpeningBook(module) {
+    if (!hasBinding(module, 'loadBook')) return;
+    try {
+        const response = await fetch(OPENING_BOOK_URL);
+        if (!response.ok) return;
+        const bytes = new Uint8Array(await response.arrayBuffer());
+        if (!module.loadBook(bytes)) {
+            console.warn("AI Worker: opening book file is invalid, searching every move.");
+        }
+    } catch (err) {
+        console.warn("AI Worker: opening book unavailable, searching every move.");
+    }
+}
+
 // Load the Wasm module once when the worker starts.
-createQuoridorAIModule().then(module => {
+createQuoridorAIModule().then(async module => {
     aiModule = module;
+    await Promise.all([loadNetworkWeights(module), loadOpeningBook(module)]);
     // Send a message back to the main thread to confirm readiness.
     self.postMessage({ type: 'worker-ready' });
 }).catch(err => {
@@ -20,14 +61,38 @@ self.onmessage = (event) => {
         return;
     }
 
-    const { type, gameState, players, difficulty } = event.data;
+    const { type, requestId, gameState, players, difficulty, searchOptions, depth, multiPV, evaluator } = event.data;
 
+    // Replies echo the request id so the controller can drop replies to requests it has abandoned.
     if (type === 'calculate-move') {
         // This is the blocking call, but it's happening on the worker thread,
         // so it doesn't freeze the UI.
-        const move = aiModule.findBestMove(gameState, players, difficulty);
+        let move = null;
+        try {
+            // Builds before the search options argument only take (state, players, depth) and play NegaMax.
+            move = aiModule.findBestMove.length >= 4
+                ? aiModule.findBestMove(gameState, players, difficulty, searchOptions || {})
+                : aiModule.findBestMove(gameState, players, difficulty);
+        } catch (err) {
+            console.error("AI Worker failed to calculate a move:", err);
+        }
         
         // Send the result back to the main thread.
-        self.postMessage({ type: 'move-calculated', move });
+        self.postMessage({ type: 'move-calculated', requestId, move });
+    } else if (type === 'analyze') {
+        if (!hasBinding(aiModule, 'analyzePosition')) {
+            self.postMessage({ type: 'analysis-error', requestId, message: 'ai.js was built without analyzePosition' });
+            return;
+        }
+        try {
+            // Each completed iteration is streamed to the main thread while the search keeps running.
+            const lines = aiModule.analyzePosition(gameState, players, { depth, multiPV: multiPV || 1, evaluator }, (info) => {
+                self.postMessage({ type: 'search-info', requestId, info });
+            });
+
+            self.postMessage({ type: 'analysis-complete', requestId, lines });
+        } catch (err) {
+            self.postMessage({ type: 'analysis-error', requestId, message: String(err && err.message || err) });
+        }
     }
 };
\ No newline at end of file
@@ -196,8 +196,11 @@ export function calculateLegalPawnMoves(pawnPositions, placedWalls, players, act
         }
     }
 
-    // Final filter to remove any moves that land on an opponent (can happen in diagonal jump logic)
-    return availablePawnMoves.filter(m => !opponentPositions.some(op => op.row === m.row && op.col === m.col));
+    // Final filter to remove any moves that land on an opponent or off the board (can happen in diagonal jump logic)
+    return availablePawnMoves.filter(m =>
+        m.row >= 0 && m.row < boardSize && m.col >= 0 && m.col < boardSize &&
+        !opponentPositions.some(op => op.row === m.row && op.col === m.col)
+    );
 }
 
 function isWallBetween(placedWalls, r1, c1, r2, c2) {
@@ -1,5 +1,7 @@
 // server/GameManager.js
 import * as GameLogic from '../common/GameLogic.js';
+import MoveHistory from './MoveHistory.js';
+import { createRulesGame } from './RulesEngine.js';
 
 export default class GameManager {
     constructor(emitter, config) {
@@ -7,22 +9,15 @@ export default class GameManager {
         this.config = config;
         this.players = config.players;
         this.timerInterval = null;
-        this.history = [];
 
         // Create the initial state using the shared game logic
         this.gameState = GameLogic.createInitialState(this.config);
-        
-        // Calculate initial available moves
-        this.gameState.availablePawnMoves = GameLogic.calculateLegalPawnMoves(
-            this.gameState.pawnPositions,
-            this.gameState.placedWalls,
-            this.players,
-            this.gameState.activePlayerIds,
-            this.gameState.playerTurnIndex,
-            this.config.boardSize
-        );
-
-        this.#recordHistory();
+
+        // The C++ rules core validates every move; gameState is the copy broadcast to clients
+        this.rules = createRulesGame(this.config);
+        this.gameState.availablePawnMoves = this.rules.legalPawnMoves();
+
+        this.history = new MoveHistory(this.gameState, this.players, this.config);
     }
 
     startServerTimer() {
@@ -48,17 +43,12 @@ export default class GameManager {
         
         this.gameState.drawOfferFrom = null;
 
-        // Use the shared game logic to apply the move
-        const newGameState = GameLogic.applyMove(this.gameState, move, this.players, this.config);
+        if (!this.#applyToRules(move)) return false;
 
-        if (newGameState) {
-            this.gameState = newGameState;
-            this.#recordHistory();
-            this.emitter.emit('game-state-updated', this.getGameState());
-            return true;
-        }
-        
-        return false;
+        this.#applyToState(move);
+        this.history.recordMove(move, this.gameState);
+        this.emitter.emit('game-state-updated', this.getGameState());
+        return true;
     }
 
     endGameAsDraw(reason) {
@@ -68,7 +58,7 @@ export default class GameManager {
         this.gameState.reason = reason;
         this.gameState.playerTurn = null;
         this.gameState.drawOfferFrom = null;
-        this.#recordHistory();
+        this.history.recordEvent(this.gameState);
         this.emitter.emit('game-state-updated', this.getGameState());
     }
 
@@ -80,17 +70,14 @@ export default class GameManager {
 
         if (this.gameState !== newGameState) {
             this.gameState = newGameState;
+            this.rules.removePlayer(losingPlayerId);
 
             // Recalculate legal moves if the game is still active
             if (this.gameState.status === 'active') {
-                 this.gameState.availablePawnMoves = GameLogic.calculateLegalPawnMoves(
-                    this.gameState.pawnPositions, this.gameState.placedWalls,
-                    this.players, this.gameState.activePlayerIds,
-                    this.gameState.playerTurnIndex, this.config.boardSize
-                );
+                this.gameState.availablePawnMoves = this.rules.legalPawnMoves();
             }
             
-            this.#recordHistory();
+            this.history.recordEvent(this.gameState);
             this.emitter.emit('game-state-updated', this.getGameState());
         }
     }
@@ -107,7 +94,45 @@ export default class GameManager {
         };
     }
 
-    #recordHistory() {
-        this.history.push(JSON.parse(JSON.stringify(this.gameState)));
+    // Stops the timer and frees the rules' WASM memory; the manager must not be used afterwards.
+    destroy() {
+        if (this.timerInterval) clearInterval(this.timerInterval);
+        this.timerInterval = null;
+        this.rules.delete();
+    }
+
+    // Validates and applies the move in the C++ rules. Returns false, changing nothing, if it is illegal.
+    #applyToRules(move) {
+        const data = move && move.data;
+        const boardSize = this.config.boardSize;
+        if (!data || !Number.isInteger(data.row) || !Number.isInteger(data.col)) return false;
+        if (data.row < 0 || data.row >= boardSize || data.col < 0 || data.col >= boardSize) return false;
+
+        if (move.type === 'cell') return this.rules.playPawn(data.row, data.col);
+        if (move.type === 'wall') return typeof data.orientation === 'string' && this.rules.placeWall(data.row, data.col, data.orientation);
+        return false;
+    }
+
+    // Mirrors a move the rules accepted onto gameState in place, instead of rebuilding the state.
+    #applyToState(move) {
+        const currentPlayerId = this.gameState.playerTurn;
+        const { row, col, orientation } = move.data;
+
+        if (move.type === 'cell') {
+            this.gameState.pawnPositions[currentPlayerId] = { row, col };
+        } else {
+            this.gameState.placedWalls.push({ row, col, orientation });
+            this.gameState.wallsLeft[currentPlayerId]--;
+        }
+
+        if (this.rules.status() === 'ended') {
+            this.gameState.status = 'ended';
+            this.gameState.winner = this.rules.winner();
+            this.gameState.reason = 'goal';
+        } else {
+            this.gameState.playerTurn = this.rules.playerTurn();
+            this.gameState.playerTurnIndex = this.rules.playerTurnIndex();
+            this.gameState.availablePawnMoves = this.rules.legalPawnMoves();
+        }
     }
 }
\ No newline at end of file
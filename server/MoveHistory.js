@@ -0,0 +1,78 @@
+// server/MoveHistory.js
+import * as GameLogic from '../common/GameLogic.js';
+
+const SNAPSHOT_INTERVAL = 16; // Plies between full state snapshots
+const EVENT_ENTRY = 0xFFFF;   // A non-move change (loss, draw); the state after it is always snapshotted
+
+// Move codes match encodeMove in client/src/ai/NegaMax.cpp: (kind << 8) | (row << 4) | col,
+// where kind is 0 for a pawn move, 1 for a horizontal wall and 2 for a vertical wall.
+export function encodeMove(move) {
+    const kind = move.type === 'cell' ? 0 : (move.data.orientation === 'horizontal' ? 1 : 2);
+    return (kind << 8) | (move.data.row << 4) | move.data.col;
+}
+
+export function decodeMove(code) {
+    const kind = code >> 8;
+    const row = (code >> 4) & 0xF;
+    const col = code & 0xF;
+    if (kind === 0) return { type: 'cell', data: { row, col } };
+    return { type: 'wall', data: { row, col, orientation: kind === 1 ? 'horizontal' : 'vertical' } };
+}
+
+/**
+ * Game history as a per-ply move log (two bytes per ply) plus a full snapshot every
+ * SNAPSHOT_INTERVAL entries. Entry 0 is the initial state. Earlier states are rebuilt on demand
+ * by replaying moves from the nearest snapshot; timers are only exact at snapshots.
+ */
+export default class MoveHistory {
+    constructor(initialState, players, config, snapshotInterval = SNAPSHOT_INTERVAL) {
+        this.players = players;
+        this.config = config;
+        this.snapshotInterval = snapshotInterval;
+        this.entries = new Uint16Array(64);
+        this.length = 0;
+        this.snapshots = new Map();
+        this.recordEvent(initialState);
+    }
+
+    recordMove(move, gameState) {
+        this.#push(encodeMove(move));
+        if ((this.length - 1) % this.snapshotInterval === 0) this.#snapshot(gameState);
+    }
+
+    recordEvent(gameState) {
+        this.#push(EVENT_ENTRY);
+        this.#snapshot(gameState);
+    }
+
+    /**
+     * Rebuilds the state after the given entry.
+     * @param {number} index Entry index, 0 being the initial state.
+     * @returns {object|null} A fresh copy of the state, or null if the index is out of range.
+     */
+    stateAt(index) {
+        if (index < 0 || index >= this.length) return null;
+
+        let base = index;
+        while (!this.snapshots.has(base)) base--;
+        let state = JSON.parse(JSON.stringify(this.snapshots.get(base)));
+
+        for (let i = base + 1; i <= index; i++) {
+            state = GameLogic.applyMove(state, decodeMove(this.entries[i]), this.players, this.config);
+        }
+        return state;
+    }
+
+    #push(entry) {
+        if (this.length === this.entries.length) {
+            const grown = new Uint16Array(this.entries.length * 2);
+            grown.set(this.entries);
+            this.entries = grown;
+        }
+        this.entries[this.length++] = entry;
+    }
+
+    #snapshot(gameState) {
+        this.snapshots.set(this.length - 1, JSON.parse(JSON.stringify(gameState)));
+    }
+}
@@ -0,0 +1,35 @@
+// server/RulesEngine.js
+// Loads the C++ rules core once per server process: the native addon built from binding.gyp
+// (server/native/RulesAddon.cpp), or else the RulesGame binding of the WASM module the client AI uses.
+import { createRequire } from 'module';
+import createQuoridorAIModule from '../public/ai/ai.js';
+
+const require = createRequire(import.meta.url);
+
+async function loadRulesGame() {
+    try {
+        return { backend: 'native', RulesGame: require('../build/Release/rules.node').RulesGame };
+    } catch (err) {
+        if (err.code !== 'MODULE_NOT_FOUND') throw err;
+    }
+
+    const aiModule = await createQuoridorAIModule();
+    if (aiModule.RulesGame) return { backend: 'wasm', RulesGame: aiModule.RulesGame };
+
+    throw new Error('No C++ rules core available: build the native addon with `npm run build:rules`, ' +
+        'or rebuild public/ai/ai.js with `npm run build:wasm`');
+}
+
+const { backend, RulesGame } = await loadRulesGame();
+
+// 'native' or 'wasm': which build of the C++ rules validates moves.
+export const rulesBackend = backend;
+
+/**
+ * Creates the authoritative rules for one game. The returned object owns native or WASM memory
+ * and must be released with `.delete()` when the game is discarded.
+ * @param {object} config The game configuration (boardSize, wallsPerPlayer, players).
+ */
+export function createRulesGame(config) {
+    return new RulesGame(config.boardSize, config.wallsPerPlayer, config.players.map(p => p.id));
+}
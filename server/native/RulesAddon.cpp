@@ -0,0 +1,219 @@
+// Native Node.js addon exposing the C++ rules core (RulesGame in NegaMax.cpp) to the server.
+// built by node-gyp from binding.gyp: npm install builds it, npm run build:rules rebuilds it.
+//
+// Exposes the same RulesGame interface as the WASM build, so server/RulesEngine.js can use either:
+//   new RulesGame(boardSize, wallsPerPlayer, playerIds)
+//   playPawn(row, col), placeWall(row, col, orientation), removePlayer(id), legalPawnMoves(),
+//   playerTurn(), playerTurnIndex(), status(), winner(), delete()
+
+#include "../../client/src/ai/NegaMax.cpp"
+
+#include <node_api.h>
+
+// --- HELPERS ---
+#define NAPI_CALL(env, call)                                                   \
+    do {                                                                       \
+        if ((call) != napi_ok) {                                               \
+            napi_throw_error((env), nullptr, "RulesGame: N-API call failed");  \
+            return nullptr;                                                    \
+        }                                                                      \
+    } while (0)
+
+struct CallInfo {
+    RulesGame* game = nullptr;
+    size_t argc = 3;
+    napi_value argv[3];
+};
+
+// Reads the arguments and the wrapped game; throws when the game was already deleted.
+bool getCallInfo(napi_env env, napi_callback_info info, CallInfo& call) {
+    napi_value self;
+    if (napi_get_cb_info(env, info, &call.argc, call.argv, &self, nullptr) != napi_ok) return false;
+    void* game = nullptr;
+    if (napi_unwrap(env, self, &game) != napi_ok || !game) {
+        napi_throw_error(env, nullptr, "RulesGame: object has been deleted");
+        return false;
+    }
+    call.game = static_cast<RulesGame*>(game);
+    return true;
+}
+
+bool getInt(napi_env env, napi_value value, int& out) {
+    int32_t number;
+    if (napi_get_value_int32(env, value, &number) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "RulesGame: expected a number");
+        return false;
+    }
+    out = number;
+    return true;
+}
+
+bool getString(napi_env env, napi_value value, std::string& out) {
+    size_t length;
+    if (napi_get_value_string_utf8(env, value, nullptr, 0, &length) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "RulesGame: expected a string");
+        return false;
+    }
+    out.resize(length);
+    napi_get_value_string_utf8(env, value, &out[0], length + 1, &length);
+    return true;
+}
+
+napi_value makeBool(napi_env env, bool value) {
+    napi_value result;
+    napi_get_boolean(env, value, &result);
+    return result;
+}
+
+napi_value makeString(napi_env env, const std::string& value) {
+    napi_value result;
+    napi_create_string_utf8(env, value.c_str(), value.size(), &result);
+    return result;
+}
+
+void finalizeGame(napi_env, void* game, void*) {
+    delete static_cast<RulesGame*>(game);
+}
+
+// --- METHODS ---
+napi_value constructGame(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    napi_value self;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &self, nullptr));
+
+    int boardSize, walls;
+    bool isArray = false;
+    if (argc < 3 || !getInt(env, argv[0], boardSize) || !getInt(env, argv[1], walls)) return nullptr;
+    napi_is_array(env, argv[2], &isArray);
+    if (!isArray || boardSize < 3 || boardSize > Zobrist::MAX_BOARD_SIZE) {
+        napi_throw_range_error(env, nullptr, "RulesGame: expected (boardSize, wallsPerPlayer, playerIds)");
+        return nullptr;
+    }
+
+    uint32_t count;
+    NAPI_CALL(env, napi_get_array_length(env, argv[2], &count));
+    std::vector<std::string> ids(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        napi_value id;
+        NAPI_CALL(env, napi_get_element(env, argv[2], i, &id));
+        if (!getString(env, id, ids[i])) return nullptr;
+    }
+    if (ids.empty()) {
+        napi_throw_range_error(env, nullptr, "RulesGame: no players");
+        return nullptr;
+    }
+
+    RulesGame* game = new RulesGame(boardSize, walls, ids);
+    if (napi_wrap(env, self, game, finalizeGame, nullptr, nullptr) != napi_ok) {
+        delete game;
+        napi_throw_error(env, nullptr, "RulesGame: could not wrap the game");
+        return nullptr;
+    }
+    return self;
+}
+
+napi_value playPawn(napi_env env, napi_callback_info info) {
+    CallInfo call;
+    int row, col;
+    if (!getCallInfo(env, info, call) || call.argc < 2 || !getInt(env, call.argv[0], row) || !getInt(env, call.argv[1], col)) return nullptr;
+    return makeBool(env, call.game->playPawn(row, col));
+}
+
+napi_value placeWall(napi_env env, napi_callback_info info) {
+    CallInfo call;
+    int row, col;
+    std::string orientation;
+    if (!getCallInfo(env, info, call) || call.argc < 3 || !getInt(env, call.argv[0], row) || !getInt(env, call.argv[1], col) ||
+        !getString(env, call.argv[2], orientation)) return nullptr;
+    return makeBool(env, call.game->placeWall(row, col, orientation));
+}
+
+napi_value removePlayer(napi_env env, napi_callback_info info) {
+    CallInfo call;
+    std::string playerId;
+    if (!getCallInfo(env, info, call) || call.argc < 1 || !getString(env, call.argv[0], playerId)) return nullptr;
+    call.game->removePlayer(playerId);
+    return nullptr;
+}
+
+napi_value legalPawnMoves(napi_env env, napi_callback_info info) {
+    CallInfo call;
+    if (!getCallInfo(env, info, call)) return nullptr;
+    std::vector<PawnPos> moves = call.game->legalPawnMoves();
+
+    napi_value jsMoves;
+    NAPI_CALL(env, napi_create_array_with_length(env, moves.size(), &jsMoves));
+    for (size_t i = 0; i < moves.size(); ++i) {
+        napi_value jsPos, row, col;
+        NAPI_CALL(env, napi_create_object(env, &jsPos));
+        NAPI_CALL(env, napi_create_int32(env, moves[i].row, &row));
+        NAPI_CALL(env, napi_create_int32(env, moves[i].col, &col));
+        NAPI_CALL(env, napi_set_named_property(env, jsPos, "row", row));
+        NAPI_CALL(env, napi_set_named_property(env, jsPos, "col", col));
+        NAPI_CALL(env, napi_set_element(env, jsMoves, static_cast<uint32_t>(i), jsPos));
+    }
+    return jsMoves;
+}
+
+napi_value playerTurn(napi_env env, napi_callback_info info) {
+    CallInfo call;
+    if (!getCallInfo(env, info, call)) return nullptr;
+    return makeString(env, call.game->playerTurn());
+}
+
+napi_value playerTurnIndex(napi_env env, napi_callback_info info) {
+    CallInfo call;
+    if (!getCallInfo(env, info, call)) return nullptr;
+    napi_value result;
+    NAPI_CALL(env, napi_create_int32(env, call.game->playerTurnIndex(), &result));
+    return result;
+}
+
+napi_value status(napi_env env, napi_callback_info info) {
+    CallInfo call;
+    if (!getCallInfo(env, info, call)) return nullptr;
+    return makeString(env, call.game->status());
+}
+
+napi_value winner(napi_env env, napi_callback_info info) {
+    CallInfo call;
+    if (!getCallInfo(env, info, call)) return nullptr;
+    return makeString(env, call.game->winner());
+}
+
+// Frees the game now, like delete() on the Embind class; the garbage collector would otherwise
+// free it whenever the wrapper is collected.
+napi_value deleteGame(napi_env env, napi_callback_info info) {
+    napi_value self;
+    size_t argc = 0;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, nullptr, &self, nullptr));
+    void* game = nullptr;
+    if (napi_remove_wrap(env, self, &game) == napi_ok) delete static_cast<RulesGame*>(game);
+    return nullptr;
+}
+
+// --- MODULE ---
+napi_value initRulesAddon(napi_env env, napi_value exports) {
+    Zobrist::initialize();
+
+    napi_property_descriptor methods[] = {
+        {"playPawn", nullptr, playPawn, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"placeWall", nullptr, placeWall, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"removePlayer", nullptr, removePlayer, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"legalPawnMoves", nullptr, legalPawnMoves, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"playerTurn", nullptr, playerTurn, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"playerTurnIndex", nullptr, playerTurnIndex, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"status", nullptr, status, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"winner", nullptr, winner, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"delete", nullptr, deleteGame, nullptr, nullptr, nullptr, napi_default, nullptr},
+    };
+
+    napi_value rulesGameClass;
+    NAPI_CALL(env, napi_define_class(env, "RulesGame", NAPI_AUTO_LENGTH, constructGame, nullptr,
+                                     sizeof(methods) / sizeof(methods[0]), methods, &rulesGameClass));
+    NAPI_CALL(env, napi_set_named_property(env, exports, "RulesGame", rulesGameClass));
+    return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, initRulesAddon)
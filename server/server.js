@@ -162,9 +162,7 @@ io.on('connection', (socket) => {
             const remainingPlayers = Object.keys(players).filter(pid => pid !== socket.id);
             if (remainingPlayers.length === 0) {
                 console.log(`Room ${roomName} is empty, deleting.`);
-                if (rooms[roomName].gameManager.timerInterval) {
-                    clearInterval(rooms[roomName].gameManager.timerInterval);
-                }
+                gameManager.destroy();
                 delete rooms[roomName];
             }
         }